@@ -1,6 +1,16 @@
 #include <iostream>
 #include <vector>
 #include <climits>
+#include <cstdint>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <random>
+#include <stdexcept>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
 using namespace std;
 
 int kadane2D(vector<vector<int>>& image) {
@@ -25,6 +35,418 @@ int kadane2D(vector<vector<int>>& image) {
     return max_sum;
 }
 
+// Winning region, inclusive bounds
+struct Rectangle {
+    int64_t sum = INT64_MIN;
+    int top = -1, left = -1, bottom = -1, right = -1;
+
+    // Larger sum wins; ties go to the smallest (left, right) so the answer
+    // does not depend on how columns were split across threads
+    bool beats(const Rectangle& other) const {
+        if (sum != other.sum) return sum > other.sum;
+        if (left != other.left) return left < other.left;
+        return right < other.right;
+    }
+};
+
+// Kadane state for every right edge of one left edge, one entry per right.
+// Rows restart when the running sum goes negative; `best` keeps the
+// earliest bottom reaching the maximum.
+struct KadaneLanes {
+    int64_t* cur;
+    int64_t* best;
+    int64_t* start;
+    int64_t* top;
+    int64_t* bottom;
+};
+
+#ifdef __AVX2__
+// V vectors of 4 right edges per pass down the rows: V = 4 reads two full
+// cache lines of each prefix row and overlaps four dependency chains
+template <int V>
+static void advanceVectors(const int64_t* prefix, size_t stride, int rows, int rowBase,
+                           int left, int r, const KadaneLanes& s) {
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i cur[V], best[V], start[V], top[V], bottom[V];
+    for (int k = 0; k < V; k++) {
+        cur[k] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s.cur + r + 4 * k));
+        best[k] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s.best + r + 4 * k));
+        start[k] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s.start + r + 4 * k));
+        top[k] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s.top + r + 4 * k));
+        bottom[k] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s.bottom + r + 4 * k));
+    }
+    for (int i = 0; i < rows; i++) {
+        const int64_t* row = prefix + i * stride;
+        __m256i row_index = _mm256_set1_epi64x(rowBase + i);
+        __m256i base = _mm256_set1_epi64x(row[left]);
+        for (int k = 0; k < V; k++) {
+            __m256i v = _mm256_sub_epi64(
+                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + left + 1 + r + 4 * k)), base);
+            __m256i restart = _mm256_cmpgt_epi64(zero, cur[k]);
+            cur[k] = _mm256_blendv_epi8(_mm256_add_epi64(cur[k], v), v, restart);
+            start[k] = _mm256_blendv_epi8(start[k], row_index, restart);
+            __m256i better = _mm256_cmpgt_epi64(cur[k], best[k]);
+            best[k] = _mm256_blendv_epi8(best[k], cur[k], better);
+            top[k] = _mm256_blendv_epi8(top[k], start[k], better);
+            bottom[k] = _mm256_blendv_epi8(bottom[k], row_index, better);
+        }
+    }
+    for (int k = 0; k < V; k++) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(s.cur + r + 4 * k), cur[k]);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(s.best + r + 4 * k), best[k]);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(s.start + r + 4 * k), start[k]);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(s.top + r + 4 * k), top[k]);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(s.bottom + r + 4 * k), bottom[k]);
+    }
+}
+#endif
+
+// Advances the Kadane state of columns [left, right] for every right >=
+// left over `rows` rows of row prefix sums (prefix[i * stride + c] = sum of
+// row i's first c pixels). The right edges are independent, so AVX2 runs
+// several of them per pass, with the row dependency kept inside each lane.
+static void advanceLanes(const int64_t* prefix, size_t stride, int rows, int rowBase,
+                         int left, int cols, const KadaneLanes& s) {
+    int lanes = cols - left;
+    int r = 0;
+#ifdef __AVX2__
+    for (; r + 16 <= lanes; r += 16) advanceVectors<4>(prefix, stride, rows, rowBase, left, r, s);
+    for (; r + 4 <= lanes; r += 4) advanceVectors<1>(prefix, stride, rows, rowBase, left, r, s);
+#endif
+    for (; r < lanes; r++) {
+        int64_t cur = s.cur[r], best = s.best[r], start = s.start[r], top = s.top[r], bottom = s.bottom[r];
+        for (int i = 0; i < rows; i++) {
+            const int64_t* row = prefix + i * stride;
+            int64_t v = row[left + 1 + r] - row[left];
+            if (cur < 0) {
+                cur = v;
+                start = rowBase + i;
+            } else {
+                cur += v;
+            }
+            if (cur > best) {
+                best = cur;
+                top = start;
+                bottom = rowBase + i;
+            }
+        }
+        s.cur[r] = cur, s.best[r] = best, s.start[r] = start, s.top[r] = top, s.bottom[r] = bottom;
+    }
+}
+
+// Row prefix sums of a row-major strip, one extra leading column per row
+static vector<int64_t> rowPrefix(const int* pixels, int rows, int cols) {
+    vector<int64_t> prefix(static_cast<size_t>(rows) * (cols + 1));
+    for (int i = 0; i < rows; i++) {
+        int64_t* out = &prefix[static_cast<size_t>(i) * (cols + 1)];
+        const int* in = pixels + static_cast<size_t>(i) * cols;
+        out[0] = 0;
+        for (int c = 0; c < cols; c++) out[c + 1] = out[c] + in[c];
+    }
+    return prefix;
+}
+
+// Runs body(left) for every left edge on `threads` threads. Work shrinks as
+// left grows, so edges are claimed one at a time from a shared counter.
+template <typename Body>
+static void forEachLeft(int cols, unsigned threads, Body body) {
+    atomic<int> next{0};
+    auto worker = [&](unsigned t) {
+        for (int left; (left = next.fetch_add(1)) < cols;) body(t, left);
+    };
+    vector<thread> pool;
+    for (unsigned t = 1; t < threads; t++) pool.emplace_back(worker, t);
+    worker(0);
+    for (auto& th : pool) th.join();
+}
+
+// Maximum-sum rectangle of a flat row-major image in O(min(r,c)^2 * max(r,c))
+// with 64-bit sums. Column pairs run over the shorter side (the image is
+// transposed if needed) and the outer left loop is shared across threads.
+Rectangle maxSumRectangle(const vector<int>& pixels, int rows, int cols,
+                          unsigned threads = thread::hardware_concurrency()) {
+    if (rows <= 0 || cols <= 0) return {};
+    threads = max(1u, threads);
+    bool transposed = cols > rows;
+    vector<int> flipped;
+    const int* data = pixels.data();
+    if (transposed) {
+        flipped.resize(pixels.size());
+        for (int i = 0; i < rows; i++)
+            for (int c = 0; c < cols; c++) flipped[static_cast<size_t>(c) * rows + i] = pixels[static_cast<size_t>(i) * cols + c];
+        data = flipped.data();
+        swap(rows, cols);
+    }
+
+    vector<int64_t> prefix = rowPrefix(data, rows, cols);
+    vector<Rectangle> found(threads);
+    vector<vector<int64_t>> scratch(threads, vector<int64_t>(5 * static_cast<size_t>(cols)));
+    forEachLeft(cols, threads, [&](unsigned t, int left) {
+        int lanes = cols - left;
+        int64_t* base = scratch[t].data();
+        KadaneLanes s{base, base + lanes, base + 2 * lanes, base + 3 * lanes, base + 4 * lanes};
+        fill(s.cur, s.cur + lanes, 0);
+        fill(s.best, s.best + lanes, INT64_MIN);
+        fill(s.start, s.start + 3 * lanes, 0); // start, top, bottom
+        advanceLanes(prefix.data(), cols + 1, rows, 0, left, cols, s);
+        for (int r = 0; r < lanes; r++) {
+            Rectangle candidate{s.best[r], static_cast<int>(s.top[r]), left, static_cast<int>(s.bottom[r]), left + r};
+            if (candidate.beats(found[t])) found[t] = candidate;
+        }
+    });
+
+    Rectangle best;
+    for (const auto& f : found)
+        if (f.beats(best)) best = f;
+    if (transposed) best = {best.sum, best.left, best.top, best.right, best.bottom};
+    return best;
+}
+
+// Tiled mode for images too large to hold: strips are fed in order and
+// dropped after use, and the result is exact. Kadane state is kept for every
+// pair of edges across the strips (40 bytes each, ~20 * span^2 in all), where
+// span is the strip width, so strips run along the longer axis: row strips
+// for tall images, column strips for wide ones. An instance may track only a
+// band of left edges [leftBegin, leftEnd); streamMaxRectangle() uses that to
+// bound memory on near-square images, where the full state would outgrow the
+// image itself (~93 MB for a 3840x2160 frame of 33 MB).
+class StreamingMaxRectangle {
+public:
+    enum class Strips { Rows, Columns };
+
+    StreamingMaxRectangle(int rows, int cols, unsigned threads = thread::hardware_concurrency(),
+                          int leftBegin = 0, int leftEnd = INT_MAX)
+        : strips(stripsFor(rows, cols)), span(min(rows, cols)), leftBegin(max(0, leftBegin)),
+          leftEnd(min(leftEnd, span)), threads(max(1u, threads)) {
+        if (rows <= 0 || cols <= 0 || this->leftBegin >= this->leftEnd)
+            throw invalid_argument("StreamingMaxRectangle needs a non-empty image and left-edge band");
+        state.resize(offset(this->leftEnd));
+        for (int left = this->leftBegin; left < this->leftEnd; left++) {
+            KadaneLanes s = lanes(left);
+            fill(s.best, s.best + (span - left), INT64_MIN);
+        }
+    }
+
+    // Strips run along the image's longer side
+    static Strips stripsFor(int rows, int cols) { return cols > rows ? Strips::Columns : Strips::Rows; }
+
+    // State for left edges [leftBegin, leftEnd) of an image whose short side is span
+    static size_t stateBytes(int span, int leftBegin, int leftEnd) {
+        auto pairsBefore = [span](size_t left) { return left * span - left * (left - 1) / 2; };
+        return 5 * sizeof(int64_t) * (pairsBefore(leftEnd) - pairsBefore(leftBegin));
+    }
+
+    Strips stripAxis() const { return strips; }
+    size_t stateBytes() const { return state.size() * sizeof(int64_t); }
+
+    // Appends `rows` full-width rows (row-major) below those seen so far
+    void addRows(const int* strip, int rows) {
+        if (strips != Strips::Rows) throw logic_error("wide image: feed column strips");
+        advance(strip, rows);
+    }
+
+    // Appends `cols` full-height columns, given as a row-major rows x cols
+    // block, to the right of those seen so far
+    void addColumns(const int* strip, int cols) {
+        if (strips != Strips::Columns) throw logic_error("tall image: feed row strips");
+        vector<int> transposed(static_cast<size_t>(cols) * span);
+        for (int i = 0; i < span; i++)
+            for (int c = 0; c < cols; c++)
+                transposed[static_cast<size_t>(c) * span + i] = strip[static_cast<size_t>(i) * cols + c];
+        advance(transposed.data(), cols);
+    }
+
+    // Best rectangle whose (strip-axis) left edge lies in this band
+    Rectangle best() {
+        Rectangle winner;
+        for (int left = leftBegin; left < leftEnd; left++) {
+            KadaneLanes s = lanes(left);
+            for (int r = 0; r < span - left; r++) {
+                Rectangle candidate{s.best[r], static_cast<int>(s.top[r]), left, static_cast<int>(s.bottom[r]), left + r};
+                if (candidate.beats(winner)) winner = candidate;
+            }
+        }
+        if (strips == Strips::Columns) winner = {winner.sum, winner.left, winner.top, winner.right, winner.bottom};
+        return winner;
+    }
+
+private:
+    Strips strips;
+    int span; // Extent across the strips, the image's shorter side
+    int leftBegin, leftEnd;
+    unsigned threads;
+    int seen = 0;
+    vector<int64_t> state; // Per left edge in the band: 5 arrays of (span - left) entries
+
+    size_t offset(int left) const { return stateBytes(span, leftBegin, left) / sizeof(int64_t); }
+
+    // Rows of `span` values each, in the orientation the state runs along
+    void advance(const int* lines, int count) {
+        vector<int64_t> prefix = rowPrefix(lines, count, span);
+        forEachLeft(leftEnd - leftBegin, threads, [&](unsigned, int i) {
+            int left = leftBegin + i;
+            advanceLanes(prefix.data(), span + 1, count, seen, left, span, lanes(left));
+        });
+        seen += count;
+    }
+
+    KadaneLanes lanes(int left) {
+        int64_t* base = state.data() + offset(left);
+        size_t n = span - left;
+        return {base, base + n, base + 2 * n, base + 3 * n, base + 4 * n};
+    }
+};
+
+// Exact maximum rectangle in bounded memory: left edges are split into bands
+// whose state fits budgetBytes (at least one edge per band), and the image is
+// streamed once per band. readStrip(first, count, out) must fill `out` with
+// strip [first, first + count) along stripsFor(rows, cols), row-major (count
+// rows of cols, or rows rows of count columns), and is called again each pass.
+template <typename ReadStrip>
+Rectangle streamMaxRectangle(int rows, int cols, size_t budgetBytes, int stripLength, ReadStrip readStrip,
+                             unsigned threads = thread::hardware_concurrency()) {
+    bool columns = StreamingMaxRectangle::stripsFor(rows, cols) == StreamingMaxRectangle::Strips::Columns;
+    int span = min(rows, cols), length = max(rows, cols);
+    stripLength = max(1, stripLength);
+    vector<int> strip;
+    Rectangle best;
+    for (int leftBegin = 0; leftBegin < span;) {
+        int leftEnd = leftBegin + 1;
+        while (leftEnd < span && StreamingMaxRectangle::stateBytes(span, leftBegin, leftEnd + 1) <= budgetBytes)
+            leftEnd++;
+        StreamingMaxRectangle band(rows, cols, threads, leftBegin, leftEnd);
+        for (int first = 0; first < length; first += stripLength) {
+            int count = min(stripLength, length - first);
+            strip.resize(static_cast<size_t>(count) * span);
+            readStrip(first, count, strip.data());
+            if (columns) band.addColumns(strip.data(), count);
+            else band.addRows(strip.data(), count);
+        }
+        Rectangle found = band.best();
+        // beats() orders by sum, then strip-axis (left, right), in any band
+        Rectangle key = columns ? Rectangle{found.sum, found.left, found.top, found.right, found.bottom} : found;
+        Rectangle bestKey = columns ? Rectangle{best.sum, best.left, best.top, best.right, best.bottom} : best;
+        if (key.beats(bestKey)) best = found;
+        leftBegin = leftEnd;
+    }
+    return best;
+}
+
+// Live 1-D intensity signal (e.g., a scanline that changes one sample at a
+// time). Each node of a bottom-up segment tree stores its sum, best prefix,
+// best suffix and best subarray, so a point update re-merges O(log n)
+// ancestors and any range's best subarray is assembled from O(log n) nodes.
+// Fields are kept as separate arrays (structure of arrays); a merge loads
+// all eight fields of both children into Node values and stores the result
+// back field by field.
+class MaxSubarrayTree {
+public:
+    struct Segment {
+        int64_t sum;
+        int left, right; // Inclusive; left > right means empty
+    };
+
+    explicit MaxSubarrayTree(const vector<int>& signal) : n(static_cast<int>(signal.size())) {
+        size = 1;
+        while (size < max(n, 1)) size <<= 1;
+        for (auto* field : {&sum, &pre, &suf, &bestSum}) field->assign(2 * size, NEG);
+        for (auto* field : {&preEnd, &sufStart, &bestLeft, &bestRight}) field->assign(2 * size, -1);
+        fill(sum.begin(), sum.end(), 0); // Padding leaves: empty, sum 0
+        for (int i = 0; i < n; i++) setLeaf(i, signal[i]);
+        for (int node = size - 1; node >= 1; node--) pull(node);
+    }
+
+    // O(log n)
+    void update(int index, int64_t value) {
+        checkIndex(index);
+        setLeaf(index, value);
+        for (int node = (index + size) >> 1; node >= 1; node >>= 1) pull(node);
+    }
+
+    // Applies all changes, then re-merges each affected ancestor once per
+    // level, so k changes in one region share their common ancestors
+    void updateBatch(const vector<pair<int, int64_t>>& changes) {
+        for (const auto& change : changes) checkIndex(change.first); // Before any write
+        vector<int> level;
+        level.reserve(changes.size());
+        for (auto [index, value] : changes) {
+            setLeaf(index, value);
+            level.push_back((index + size) >> 1);
+        }
+        sort(level.begin(), level.end());
+        level.erase(unique(level.begin(), level.end()), level.end());
+        while (!level.empty() && level[0] >= 1) {
+            for (int node : level) pull(node);
+            for (int& node : level) node >>= 1; // Still sorted, maybe with repeats
+            level.erase(unique(level.begin(), level.end()), level.end());
+            if (level[0] == 0) break;
+        }
+    }
+
+    // Highest-sum subarray inside [l, r], O(log n)
+    Segment query(int l, int r) const {
+        if (l < 0 || l > r || r >= n) throw out_of_range("MaxSubarrayTree query needs 0 <= l <= r < size");
+        Node fromLeft = identity(), fromRight = identity();
+        for (l += size, r += size + 1; l < r; l >>= 1, r >>= 1) {
+            if (l & 1) fromLeft = merge(fromLeft, load(l++));
+            if (r & 1) fromRight = merge(load(--r), fromRight);
+        }
+        Node result = merge(fromLeft, fromRight);
+        return {result.best, result.bestLeft, result.bestRight};
+    }
+
+    Segment best() const { return {bestSum[1], bestLeft[1], bestRight[1]}; }
+
+private:
+    static constexpr int64_t NEG = INT64_MIN / 4; // "No subarray"; sums of two stay in range
+
+    struct Node {
+        int64_t sum, pre, suf, best;
+        int preEnd, sufStart, bestLeft, bestRight;
+    };
+
+    static Node identity() { return {0, NEG, NEG, NEG, -1, -1, -1, -1}; }
+
+    static Node merge(const Node& a, const Node& b) {
+        Node m;
+        m.sum = a.sum + b.sum;
+        if (a.pre >= a.sum + b.pre) m.pre = a.pre, m.preEnd = a.preEnd;
+        else m.pre = a.sum + b.pre, m.preEnd = b.preEnd;
+        if (b.suf >= b.sum + a.suf) m.suf = b.suf, m.sufStart = b.sufStart;
+        else m.suf = b.sum + a.suf, m.sufStart = a.sufStart;
+        m.best = a.best, m.bestLeft = a.bestLeft, m.bestRight = a.bestRight;
+        if (a.suf + b.pre > m.best) m.best = a.suf + b.pre, m.bestLeft = a.sufStart, m.bestRight = b.preEnd;
+        if (b.best > m.best) m.best = b.best, m.bestLeft = b.bestLeft, m.bestRight = b.bestRight;
+        return m;
+    }
+
+    Node load(int node) const {
+        return {sum[node], pre[node], suf[node], bestSum[node],
+                preEnd[node], sufStart[node], bestLeft[node], bestRight[node]};
+    }
+
+    void pull(int node) {
+        Node m = merge(load(2 * node), load(2 * node + 1));
+        sum[node] = m.sum, pre[node] = m.pre, suf[node] = m.suf, bestSum[node] = m.best;
+        preEnd[node] = m.preEnd, sufStart[node] = m.sufStart;
+        bestLeft[node] = m.bestLeft, bestRight[node] = m.bestRight;
+    }
+
+    void checkIndex(int index) const {
+        if (index < 0 || index >= n) throw out_of_range("MaxSubarrayTree index out of range");
+    }
+
+    void setLeaf(int index, int64_t value) {
+        int node = index + size;
+        sum[node] = pre[node] = suf[node] = bestSum[node] = value;
+        preEnd[node] = sufStart[node] = bestLeft[node] = bestRight[node] = index;
+    }
+
+    int n, size;
+    vector<int64_t> sum, pre, suf, bestSum;
+    vector<int> preEnd, sufStart, bestLeft, bestRight;
+};
+
 int main() {
     // Pixel intensity matrix (e.g., grayscale values)
     vector<vector<int>> image = {
@@ -34,6 +456,78 @@ int main() {
         {-4, -1, 1, 7}
     };
     cout << "Maximum visual intensity region sum: " << kadane2D(image) << endl;
+
+    // Same image as one flat row-major buffer, now with the region itself
+    vector<int> flat;
+    for (auto& row : image) flat.insert(flat.end(), row.begin(), row.end());
+    Rectangle region = maxSumRectangle(flat, 4, 4);
+    cout << "Region rows " << region.top << "-" << region.bottom << ", columns " << region.left << "-"
+         << region.right << " (sum " << region.sum << ")" << endl;
+
+    // Centered intensities of a larger frame: in-memory vs streamed in strips
+    const int rows = 2160, cols = 360;
+    mt19937 rng(5);
+    vector<int> frame(static_cast<size_t>(rows) * cols);
+    for (int i = 0; i < rows; i++)
+        for (int c = 0; c < cols; c++)
+            frame[static_cast<size_t>(i) * cols + c] = static_cast<int>(rng() % 256) - 128 + (i > 1200 && i < 1400 && c > 100 && c < 180 ? 6 : 0);
+
+    auto start = chrono::steady_clock::now();
+    Rectangle whole = maxSumRectangle(frame, rows, cols);
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout << rows << "x" << cols << " frame: rows " << whole.top << "-" << whole.bottom << ", columns "
+         << whole.left << "-" << whole.right << " (sum " << whole.sum << ") in " << seconds << "s" << endl;
+
+    StreamingMaxRectangle streamed(rows, cols);
+    for (int i = 0; i < rows; i += 128)
+        streamed.addRows(&frame[static_cast<size_t>(i) * cols], min(128, rows - i));
+    Rectangle tiled = streamed.best();
+    cout << "Streamed in 128-row strips: rows " << tiled.top << "-" << tiled.bottom << ", columns "
+         << tiled.left << "-" << tiled.right << " (sum " << tiled.sum << "), "
+         << streamed.stateBytes() / (1 << 20) << " MiB of state" << endl;
+
+    // Same frame under a 512 KiB state budget: several passes over the strips
+    const size_t budget = 512 << 10;
+    int passes = 0;
+    Rectangle bounded = streamMaxRectangle(rows, cols, budget, 128, [&](int first, int count, int* out) {
+        passes += first == 0;
+        copy_n(&frame[static_cast<size_t>(first) * cols], static_cast<size_t>(count) * cols, out);
+    });
+    cout << "Within " << (budget >> 10) << " KiB of state (" << passes << " passes): rows " << bounded.top << "-"
+         << bounded.bottom << ", columns " << bounded.left << "-" << bounded.right << " (sum " << bounded.sum
+         << ")" << endl;
+
+    // A wide panorama is streamed in column strips, keeping state O(rows^2)
+    const int panoRows = 240, panoCols = 2400, stripCols = 256;
+    vector<int> panorama(static_cast<size_t>(panoRows) * panoCols);
+    for (int i = 0; i < panoRows; i++)
+        for (int c = 0; c < panoCols; c++)
+            panorama[static_cast<size_t>(i) * panoCols + c] = static_cast<int>(rng() % 256) - 128 + (i > 50 && i < 90 && c > 1500 && c < 1700 ? 8 : 0);
+    StreamingMaxRectangle wide(panoRows, panoCols);
+    vector<int> strip;
+    for (int c = 0; c < panoCols; c += stripCols) {
+        int width = min(stripCols, panoCols - c);
+        strip.resize(static_cast<size_t>(panoRows) * width);
+        for (int i = 0; i < panoRows; i++)
+            copy_n(&panorama[static_cast<size_t>(i) * panoCols + c], width, &strip[static_cast<size_t>(i) * width]);
+        wide.addColumns(strip.data(), width);
+    }
+    Rectangle pano = wide.best();
+    cout << panoRows << "x" << panoCols << " panorama in " << stripCols << "-column strips: rows " << pano.top << "-"
+         << pano.bottom << ", columns " << pano.left << "-" << pano.right << " (sum " << pano.sum << "), "
+         << wide.stateBytes() / (1 << 20) << " MiB of state" << endl;
+
+    // Live scanline: samples change one at a time, the region stays current
+    vector<int> scanline = {3, -2, 5, -9, 4, 6, -1, -7, 2, 8};
+    MaxSubarrayTree live(scanline);
+    auto peak = live.best();
+    cout << "Scanline peak: samples " << peak.left << "-" << peak.right << " (sum " << peak.sum << ")" << endl;
+    live.update(3, 10);                        // Sample 3 brightens
+    live.updateBatch({{7, 5}, {8, 3}, {9, -4}}); // A burst of nearby changes
+    peak = live.best();
+    cout << "After updates: samples " << peak.left << "-" << peak.right << " (sum " << peak.sum << ")" << endl;
+    auto window = live.query(4, 8);
+    cout << "Best within samples 4-8: " << window.left << "-" << window.right << " (sum " << window.sum << ")" << endl;
     return 0;
 }
 
@@ -41,5 +535,9 @@ int main() {
  * How This Solves the Challenge:
  * - Scans image to find the highest visual impact region (e.g., textured area).
  * - Replaces manual selection with O(M×N) automated detection.
+ * - Returns the region's coordinates, using 64-bit sums, SIMD lanes and all cores.
+ * - Streams images too large for memory strip by strip along the longer side,
+ *   in several passes when a memory budget caps the state.
+ * - Keeps the peak region of live 1-D signals current in O(log n) per change.
  * - Accelerates moodboard creation start time by 70%.
- */
\ No newline at end of file
+ */
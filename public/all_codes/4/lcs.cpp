@@ -1,6 +1,15 @@
 #include <iostream>
 #include <vector>
 #include <algorithm>
+#include <unordered_map>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <cstdint>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
 using namespace std;
 
 int lcs(vector<int>& style1, vector<int>& style2) {
@@ -18,11 +27,374 @@ int lcs(vector<int>& style1, vector<int>& style2) {
     return dp[m][n];
 }
 
+// Bit-parallel LCS length against one fixed reference (Allison-Dix / Hyyrö).
+// Column j of the DP is kept as a bit vector V over the reference, where a
+// 0 bit marks a row at which the LCS grows; one candidate symbol updates 64
+// cells per word with V = (V + U) | (V - U), U = V & match(symbol). Match
+// masks are built once per reference and shared by every scoring thread.
+class LcsReference {
+    size_t m, words;
+    vector<uint64_t> masks;          // Row r = match mask of one symbol; row 0 is all zeros
+    int lo = 0;                      // Symbol -> row as a dense table when the range is small
+    vector<uint32_t> denseRows;
+    unordered_map<int, uint32_t> sparseRows;
+
+    uint32_t row(int symbol) const {
+        if (!denseRows.empty()) {
+            int64_t k = static_cast<int64_t>(symbol) - lo;
+            return k >= 0 && k < static_cast<int64_t>(denseRows.size()) ? denseRows[k] : 0;
+        }
+        auto it = sparseRows.find(symbol);
+        return it != sparseRows.end() ? it->second : 0;
+    }
+
+    // Zero bits among the reference's m positions
+    int lcsFromColumn(const uint64_t* v, size_t stride) const {
+        if (m == 0) return 0;
+        size_t ones = 0;
+        for (size_t w = 0; w < words; w++) {
+            uint64_t bits = v[w * stride];
+            if (w == words - 1 && m % 64) bits &= (uint64_t(1) << (m % 64)) - 1;
+            ones += __builtin_popcountll(bits);
+        }
+        return static_cast<int>(m - ones);
+    }
+
+#ifdef __AVX2__
+    static __m256i lessUnsigned(__m256i a, __m256i b) {
+        const __m256i sign = _mm256_set1_epi64x(INT64_MIN);
+        return _mm256_cmpgt_epi64(_mm256_xor_si256(b, sign), _mm256_xor_si256(a, sign));
+    }
+
+    // Four candidates at once, one per 64-bit lane, words carried per lane
+    void score4(const vector<int>* const* group, int* out, vector<uint64_t>& column) const {
+        column.assign(words * 4, ~uint64_t(0));
+        size_t longest = 0;
+        for (int l = 0; l < 4; l++) longest = max(longest, group[l]->size());
+        for (size_t t = 0; t < longest; t++) {
+            const uint64_t* match[4]; // Plain loads beat hardware gathers here
+            for (int l = 0; l < 4; l++)
+                match[l] = &masks[t < group[l]->size() ? row((*group[l])[t]) * words : 0];
+            __m256i carry = _mm256_setzero_si256(); // All ones when set
+            for (size_t w = 0; w < words; w++) {
+                __m256i pm = _mm256_set_epi64x(static_cast<int64_t>(match[3][w]), static_cast<int64_t>(match[2][w]),
+                                               static_cast<int64_t>(match[1][w]), static_cast<int64_t>(match[0][w]));
+                __m256i* slot = reinterpret_cast<__m256i*>(column.data() + w * 4);
+                __m256i v = _mm256_loadu_si256(slot);
+                __m256i u = _mm256_and_si256(v, pm);
+                __m256i sum = _mm256_add_epi64(v, u);
+                __m256i overflow = lessUnsigned(sum, v);
+                __m256i withCarry = _mm256_sub_epi64(sum, carry);
+                carry = _mm256_or_si256(overflow, lessUnsigned(withCarry, sum));
+                _mm256_storeu_si256(slot, _mm256_or_si256(withCarry, _mm256_andnot_si256(u, v)));
+            }
+        }
+        for (int l = 0; l < 4; l++) out[l] = lcsFromColumn(column.data() + l, 4);
+    }
+#endif
+
+#ifdef __AVX512F__
+    // Eight candidates at once; carries live in mask registers
+    void score8(const vector<int>* const* group, int* out, vector<uint64_t>& column) const {
+        column.assign(words * 8, ~uint64_t(0));
+        size_t longest = 0;
+        for (int l = 0; l < 8; l++) longest = max(longest, group[l]->size());
+        const __m512i one = _mm512_set1_epi64(1);
+        for (size_t t = 0; t < longest; t++) {
+            const uint64_t* match[8];
+            for (int l = 0; l < 8; l++)
+                match[l] = &masks[t < group[l]->size() ? row((*group[l])[t]) * words : 0];
+            __mmask8 carry = 0;
+            for (size_t w = 0; w < words; w++) {
+                alignas(64) uint64_t lanes[8];
+                for (int l = 0; l < 8; l++) lanes[l] = match[l][w];
+                uint64_t* slot = column.data() + w * 8;
+                __m512i v = _mm512_loadu_si512(slot);
+                __m512i u = _mm512_and_si512(v, _mm512_load_si512(lanes));
+                __m512i sum = _mm512_add_epi64(v, u);
+                __mmask8 overflow = _mm512_cmplt_epu64_mask(sum, v);
+                __m512i withCarry = _mm512_mask_add_epi64(sum, carry, sum, one);
+                carry = overflow | _mm512_cmplt_epu64_mask(withCarry, sum);
+                _mm512_storeu_si512(slot, _mm512_ternarylogic_epi64(withCarry, u, v, 0xF2)); // sum | (v & ~u)
+            }
+        }
+        for (int l = 0; l < 8; l++) out[l] = lcsFromColumn(column.data() + l, 8);
+    }
+#endif
+
+public:
+    explicit LcsReference(const vector<int>& reference)
+        : m(reference.size()), words(max<size_t>(1, (reference.size() + 63) / 64)), masks(words, 0) {
+        if (!reference.empty()) {
+            auto [mn, mx] = minmax_element(reference.begin(), reference.end());
+            if (static_cast<int64_t>(*mx) - *mn < (1 << 16)) {
+                lo = *mn;
+                denseRows.assign(static_cast<size_t>(*mx - *mn) + 1, 0);
+            }
+        }
+        for (size_t i = 0; i < m; i++) {
+            uint32_t r = row(reference[i]);
+            if (r == 0) {
+                r = static_cast<uint32_t>(masks.size() / words);
+                masks.resize(masks.size() + words, 0);
+                if (!denseRows.empty()) denseRows[reference[i] - lo] = r;
+                else sparseRows.emplace(reference[i], r);
+            }
+            masks[r * words + i / 64] |= uint64_t(1) << (i % 64);
+        }
+    }
+
+    // O(n * ceil(m / 64)) time, O(m / 64) extra memory
+    int score(const vector<int>& candidate) const {
+        if (words == 1) { // Reference fits one word: no carries to chain
+            uint64_t v = ~uint64_t(0);
+            for (int symbol : candidate) {
+                uint64_t u = v & masks[row(symbol)];
+                v = (v + u) | (v - u);
+            }
+            return lcsFromColumn(&v, 1);
+        }
+        vector<uint64_t> v(words, ~uint64_t(0));
+        for (int symbol : candidate) {
+            const uint64_t* match = &masks[row(symbol) * words];
+            uint64_t carry = 0;
+            for (size_t w = 0; w < words; w++) {
+                uint64_t u = v[w] & match[w];
+                uint64_t sum = v[w] + u;
+                uint64_t withCarry = sum + carry;
+                carry = (sum < v[w]) | (withCarry < sum);
+                v[w] = withCarry | (v[w] & ~u);
+            }
+        }
+        return lcsFromColumn(v.data(), 1);
+    }
+
+    // One reference against many candidates: threads take chunks of the
+    // batch dynamically, and each thread scores 8 (AVX-512) or 4 (AVX2)
+    // candidates per pass, one per vector lane
+    vector<int> scoreBatch(const vector<vector<int>>& candidates,
+                           unsigned threads = thread::hardware_concurrency()) const {
+        vector<int> scores(candidates.size());
+        atomic<size_t> next{0};
+        const size_t chunk = 256;
+        auto worker = [&]() {
+            vector<uint64_t> column;
+            for (size_t begin; (begin = next.fetch_add(chunk)) < candidates.size();) {
+                size_t end = min(candidates.size(), begin + chunk), i = begin;
+#ifdef __AVX512F__
+                for (; i + 8 <= end; i += 8) {
+                    const vector<int>* group[8];
+                    for (int l = 0; l < 8; l++) group[l] = &candidates[i + l];
+                    score8(group, &scores[i], column);
+                }
+#endif
+#ifdef __AVX2__
+                for (; i + 4 <= end; i += 4) {
+                    const vector<int>* group[4];
+                    for (int l = 0; l < 4; l++) group[l] = &candidates[i + l];
+                    score4(group, &scores[i], column);
+                }
+#endif
+                for (; i < end; i++) scores[i] = score(candidates[i]);
+            }
+        };
+        vector<thread> pool;
+        for (unsigned t = 1; t < max(1u, threads); t++) pool.emplace_back(worker);
+        worker();
+        for (auto& th : pool) th.join();
+        return scores;
+    }
+};
+
+struct LcsAlignment {
+    vector<int> common;              // The common subsequence itself
+    vector<pair<int, int>> matches;  // (index in style1, index in style2) per element
+};
+
+// Same row, 64 cells per word op, when ys has a small alphabet: after the
+// Hyyrö pass over xs, the zero bits of V among ys's first k positions count
+// LCS(xs, ys[0, k)). Returns false (row untouched) for wide alphabets, whose
+// match masks would outgrow the O(n) memory budget.
+static bool bitParallelRow(const vector<int>& xs, const vector<int>& ys, vector<int>& row) {
+    const size_t maxSymbols = 64;
+    unordered_map<int, uint32_t> symbolRow;
+    for (int y : ys) {
+        symbolRow.emplace(y, static_cast<uint32_t>(symbolRow.size()));
+        if (symbolRow.size() > maxSymbols) return false;
+    }
+    size_t n = ys.size(), words = (n + 63) / 64;
+    vector<uint64_t> masks(symbolRow.size() * words, 0), v(words, ~uint64_t(0));
+    for (size_t k = 0; k < n; k++) masks[symbolRow[ys[k]] * words + k / 64] |= uint64_t(1) << (k % 64);
+
+    for (int x : xs) {
+        auto it = symbolRow.find(x);
+        if (it == symbolRow.end()) continue; // No match anywhere: V is unchanged
+        const uint64_t* match = &masks[it->second * words];
+        uint64_t carry = 0;
+        for (size_t w = 0; w < words; w++) {
+            uint64_t u = v[w] & match[w];
+            uint64_t sum = v[w] + u;
+            uint64_t withCarry = sum + carry;
+            carry = (sum < v[w]) | (withCarry < sum);
+            v[w] = withCarry | (v[w] & ~u);
+        }
+    }
+    row.assign(n + 1, 0);
+    for (size_t k = 0; k < n; k++) row[k + 1] = row[k] + !((v[k / 64] >> (k % 64)) & 1);
+    return true;
+}
+
+// row[k] = LCS(a[aLo, aHi), b[bLo, bLo + k)), or with reverse = true
+// row[k] = LCS(a[aLo, aHi), b[bHi - k, bHi)). One row of memory.
+static void lcsLastRow(const vector<int>& a, int aLo, int aHi, const vector<int>& b, int bLo, int bHi,
+                       bool reverse, vector<int>& row) {
+    // Contiguous, already-oriented copies keep the inner loop branch-free
+    vector<int> xs(a.begin() + aLo, a.begin() + aHi), ys(b.begin() + bLo, b.begin() + bHi);
+    if (reverse) {
+        std::reverse(xs.begin(), xs.end());
+        std::reverse(ys.begin(), ys.end());
+    }
+    if (bitParallelRow(xs, ys, row)) return;
+
+    int n = bHi - bLo;
+    row.assign(n + 1, 0);
+    int* r = row.data();
+    for (int x : xs) {
+        int diag = 0, left = 0; // row[k - 1] before and after this pass
+        for (int k = 1; k <= n; k++) {
+            int above = r[k];
+            // On a match diag + 1 always wins, so a branch-free max suffices
+            left = max(max(above, left), (diag + 1) & -static_cast<int>(x == ys[k - 1]));
+            r[k] = left;
+            diag = above;
+        }
+    }
+}
+
+// Small blocks are solved with a full table, which is cheaper than more
+// splitting once it fits in cache (BASE_CELLS ints = 256 KB)
+static constexpr long long BASE_CELLS = 1 << 16;
+
+static void alignBlock(const vector<int>& a, int aLo, int aHi, const vector<int>& b, int bLo, int bHi,
+                       vector<pair<int, int>>& out) {
+    int m = aHi - aLo, n = bHi - bLo;
+    vector<int> dp((m + 1) * (n + 1), 0);
+    auto at = [&](int i, int j) -> int& { return dp[i * (n + 1) + j]; };
+    for (int i = 1; i <= m; i++)
+        for (int j = 1; j <= n; j++)
+            at(i, j) = a[aLo + i - 1] == b[bLo + j - 1] ? at(i - 1, j - 1) + 1 : max(at(i - 1, j), at(i, j - 1));
+
+    size_t first = out.size();
+    for (int i = m, j = n; i > 0 && j > 0;) {
+        if (a[aLo + i - 1] == b[bLo + j - 1]) {
+            out.push_back({aLo + i - 1, bLo + j - 1});
+            i--, j--;
+        } else if (at(i - 1, j) >= at(i, j - 1)) {
+            i--;
+        } else {
+            j--;
+        }
+    }
+    reverse(out.begin() + first, out.end());
+}
+
+// Hirschberg: split style1 in half, find where an optimal alignment crosses
+// the middle from a forward and a backward row, then solve both quadrants.
+// The two quadrants (and the two rows) are independent, so the top
+// `parallelDepth` levels run them on separate threads.
+static void hirschberg(const vector<int>& a, int aLo, int aHi, const vector<int>& b, int bLo, int bHi,
+                       int parallelDepth, vector<pair<int, int>>& out) {
+    if (aLo >= aHi || bLo >= bHi) return;
+    if (static_cast<long long>(aHi - aLo) * (bHi - bLo) <= BASE_CELLS || aHi - aLo == 1) {
+        alignBlock(a, aLo, aHi, b, bLo, bHi, out);
+        return;
+    }
+
+    int mid = aLo + (aHi - aLo) / 2, n = bHi - bLo;
+    vector<int> forward, backward;
+    if (parallelDepth > 0) {
+        thread backwardRow([&] { lcsLastRow(a, mid, aHi, b, bLo, bHi, true, backward); });
+        lcsLastRow(a, aLo, mid, b, bLo, bHi, false, forward);
+        backwardRow.join();
+    } else {
+        lcsLastRow(a, aLo, mid, b, bLo, bHi, false, forward);
+        lcsLastRow(a, mid, aHi, b, bLo, bHi, true, backward);
+    }
+    int split = 0, best = -1;
+    for (int k = 0; k <= n; k++) {
+        if (forward[k] + backward[n - k] > best) {
+            best = forward[k] + backward[n - k];
+            split = k;
+        }
+    }
+    vector<int>().swap(forward); // Release the rows before recursing
+    vector<int>().swap(backward);
+
+    if (parallelDepth > 0) {
+        vector<pair<int, int>> right;
+        thread rightHalf([&] { hirschberg(a, mid, aHi, b, bLo + split, bHi, parallelDepth - 1, right); });
+        hirschberg(a, aLo, mid, b, bLo, bLo + split, parallelDepth - 1, out);
+        rightHalf.join();
+        out.insert(out.end(), right.begin(), right.end());
+    } else {
+        hirschberg(a, aLo, mid, b, bLo, bLo + split, 0, out);
+        hirschberg(a, mid, aHi, b, bLo + split, bHi, 0, out);
+    }
+}
+
+// The LCS and its index mapping in O(m + n) memory and O(m * n) time
+LcsAlignment lcsAlign(const vector<int>& style1, const vector<int>& style2,
+                      unsigned threads = thread::hardware_concurrency()) {
+    int parallelDepth = 0;
+    while ((1u << parallelDepth) < threads) parallelDepth++;
+
+    LcsAlignment result;
+    hirschberg(style1, 0, static_cast<int>(style1.size()), style2, 0, static_cast<int>(style2.size()),
+               parallelDepth, result.matches);
+    result.common.reserve(result.matches.size());
+    for (auto [i, j] : result.matches) result.common.push_back(style1[i]);
+    return result;
+}
+
 int main() {
     // Style sequences (e.g., gradient steps: 1=light, 5=dark)
     vector<int> style1 = {1, 2, 3, 4, 5};
     vector<int> style2 = {1, 3, 5, 2, 4};
     cout << "Style consistency score: " << lcs(style1, style2) << "/5" << endl;
+
+    // One reference style scored against a large pool of candidate styles
+    LcsReference reference(style1);
+    cout << "Bit-parallel score: " << reference.score(style2) << "/5" << endl;
+
+    // Which steps line up, not just how many
+    LcsAlignment alignment = lcsAlign(style1, style2);
+    cout << "Shared steps:";
+    for (auto [i, j] : alignment.matches)
+        cout << " " << style1[i] << " (" << i << "->" << j << ")";
+    cout << endl;
+
+    mt19937 rng(3);
+    vector<int> longStyle(300);
+    for (int& step : longStyle) step = rng() % 16;
+    vector<vector<int>> candidates(200000, vector<int>(300));
+    for (auto& candidate : candidates)
+        for (int& step : candidate) step = rng() % 16;
+    LcsReference longReference(longStyle);
+    auto start = chrono::steady_clock::now();
+    vector<int> scores = longReference.scoreBatch(candidates);
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout << "Scored " << candidates.size() << " candidates of length 300 in " << seconds << "s, best "
+         << *max_element(scores.begin(), scores.end()) << "/300" << endl;
+
+    // Long gradient sequences: alignment without the quadratic table
+    vector<int> gradientA(100000), gradientB(100000);
+    for (int& step : gradientA) step = rng() % 8;
+    for (int& step : gradientB) step = rng() % 8;
+    start = chrono::steady_clock::now();
+    LcsAlignment longAlignment = lcsAlign(gradientA, gradientB);
+    seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout << "Aligned two 100000-step gradients in " << seconds << "s: " << longAlignment.common.size()
+         << " shared steps (bit-parallel length " << LcsReference(gradientA).score(gradientB) << ")" << endl;
     return 0;
 }
 
@@ -30,5 +402,8 @@ int main() {
  * How This Solves the Challenge:
  * - Measures alignment of style sequences (e.g., gradient progressions).
  * - Ensures moodboard elements share common visual patterns.
+ * - Bit-parallel scoring checks 64 alignment cells per word operation, so one
+ *   reference is ranked against millions of candidates.
+ * - Hirschberg alignment recovers which steps match in linear memory.
  * - Improves aesthetic consistency by 45% compared to unaligned approaches.
  */
\ No newline at end of file
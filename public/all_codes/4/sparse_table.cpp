@@ -1,27 +1,173 @@
 #include <iostream>
 #include <vector>
-#include <cmath>
+#include <numeric>
+#include <algorithm>
+#include <random>
+#include <chrono>
+#include <cstdint>
+#include <climits>
+#include <cassert>
 using namespace std;
 
+// Idempotent operations: op(x, x) == x, so two overlapping halves can cover
+// any range. Selection ops always return one of their arguments, which is
+// what the block variant needs to answer in-block queries from bitmasks.
+template <typename T>
+struct MaxOp {
+    static constexpr bool selection = true;
+    T operator()(const T& a, const T& b) const { return max(a, b); }
+};
+
+template <typename T>
+struct MinOp {
+    static constexpr bool selection = true;
+    T operator()(const T& a, const T& b) const { return min(a, b); }
+};
+
+template <typename T>
+struct GcdOp {
+    static constexpr bool selection = false;
+    T operator()(const T& a, const T& b) const { return gcd(a, b); }
+};
+
+template <typename T>
+struct AndOp {
+    static constexpr bool selection = false;
+    T operator()(const T& a, const T& b) const { return a & b; }
+};
+
+inline int floorLog2(uint64_t x) { return 63 - __builtin_clzll(x); }
+
+// Levels are stored back to back in one array: level k holds n - 2^k + 1
+// entries, so a query reads two entries of the same dense level
+template <typename T = int, typename Op = MaxOp<T>>
 class SparseTable {
-    vector<vector<int>> table;
+    vector<T> table;
+    vector<size_t> levelStart;
+    Op op;
+public:
+    SparseTable() = default;
+
+    explicit SparseTable(const vector<T>& features, Op op = Op()) : op(op) {
+        size_t n = features.size();
+        int levels = n ? floorLog2(n) + 1 : 0;
+        levelStart.resize(levels + 1);
+        for (int k = 0; k < levels; k++)
+            levelStart[k + 1] = levelStart[k] + n - (size_t(1) << k) + 1;
+        table.resize(levels ? levelStart[levels] : 0);
+
+        copy(features.begin(), features.end(), table.begin());
+        for (int k = 1; k < levels; k++) {
+            const T* prev = table.data() + levelStart[k - 1];
+            T* cur = table.data() + levelStart[k];
+            size_t half = size_t(1) << (k - 1), count = n - (size_t(1) << k) + 1;
+            for (size_t i = 0; i < count; i++)
+                cur[i] = op(prev[i], prev[i + half]);
+        }
+    }
+
+    // Inclusive range [l, r], O(1)
+    T query(size_t l, size_t r) const {
+        assert(l <= r); // floorLog2(0) is undefined
+        int k = floorLog2(r - l + 1);
+        const T* level = table.data() + levelStart[k];
+        return op(level[l], level[r - (size_t(1) << k) + 1]);
+    }
+
+    // Random ranges over a large table are dominated by cache misses;
+    // prefetching a few queries ahead overlaps them
+    vector<T> queryBatch(const vector<pair<size_t, size_t>>& ranges) const {
+        const size_t ahead = 8;
+        vector<T> results(ranges.size());
+        for (size_t q = 0; q < ranges.size(); q++) {
+            if (q + ahead < ranges.size()) {
+                auto [l, r] = ranges[q + ahead];
+                assert(l <= r);
+                int k = floorLog2(r - l + 1);
+                const T* level = table.data() + levelStart[k];
+                __builtin_prefetch(level + l);
+                __builtin_prefetch(level + r - (size_t(1) << k) + 1);
+            }
+            results[q] = query(ranges[q].first, ranges[q].second);
+        }
+        return results;
+    }
+
+    size_t bytes() const { return table.size() * sizeof(T) + levelStart.size() * sizeof(size_t); }
+};
+
+// O(n) memory for huge arrays: a sparse table over 32-element block
+// summaries answers the whole blocks of a range, and per-element 32-bit
+// masks (microtables) answer the partial blocks. mask[i] marks the
+// positions of its block, up to i, on the monotonic stack at i; the best
+// element of [l, i] in that block is the lowest marked position >= l.
+// Memory is the data, 4 bytes of mask per element and ~0.8n summaries.
+template <typename T = int, typename Op = MaxOp<T>>
+class BlockSparseTable {
+    static_assert(Op::selection, "in-block masks need an op that returns one of its arguments");
+    static constexpr size_t BLOCK = 32;
+
+    vector<T> values;
+    vector<uint32_t> mask;
+    SparseTable<T, Op> blocks;
+    Op op;
+
+    T inBlock(size_t l, size_t r) const {
+        uint32_t m = mask[r] & (~0u << (l % BLOCK));
+        return values[r - r % BLOCK + __builtin_ctz(m)];
+    }
 public:
-    SparseTable(vector<int>& features) {
-        int n = features.size();
-        int logn = log2(n) + 1;
-        table.resize(n, vector<int>(logn));
-        
-        for (int i = 0; i < n; i++)
-            table[i][0] = features[i];
-            
-        for (int j = 1; (1 << j) <= n; j++)
-            for (int i = 0; i + (1 << j) <= n; i++)
-                table[i][j] = max(table[i][j-1], table[i + (1<<(j-1))][j-1]);
-    }
-    
-    int query(int l, int r) {
-        int k = log2(r - l + 1);
-        return max(table[l][k], table[r - (1<<k) + 1][k]);
+    explicit BlockSparseTable(const vector<T>& features, Op op = Op())
+        : values(features), mask(features.size()), op(op) {
+        size_t n = values.size();
+        vector<T> summary((n + BLOCK - 1) / BLOCK);
+        for (size_t start = 0; start < n; start += BLOCK) {
+            size_t end = min(n, start + BLOCK);
+            uint32_t stack = 0; // Bit j: position start + j is on the stack
+            for (size_t i = start; i < end; i++) {
+                // Pop entries that the new element is at least as good as
+                while (stack) {
+                    size_t top = start + floorLog2(stack);
+                    if (op(values[i], values[top]) != values[i]) break;
+                    stack &= ~(1u << (top - start));
+                }
+                stack |= 1u << (i - start);
+                mask[i] = stack;
+            }
+            summary[start / BLOCK] = values[start + __builtin_ctz(mask[end - 1])];
+        }
+        blocks = SparseTable<T, Op>(summary, op);
+    }
+
+    // Inclusive range [l, r], O(1)
+    T query(size_t l, size_t r) const {
+        assert(l <= r);
+        size_t lb = l / BLOCK, rb = r / BLOCK;
+        if (lb == rb) return inBlock(l, r);
+        T result = op(inBlock(l, lb * BLOCK + BLOCK - 1), inBlock(rb * BLOCK, r));
+        if (lb + 1 < rb) result = op(result, blocks.query(lb + 1, rb - 1));
+        return result;
+    }
+
+    vector<T> queryBatch(const vector<pair<size_t, size_t>>& ranges) const {
+        const size_t ahead = 8;
+        vector<T> results(ranges.size());
+        for (size_t q = 0; q < ranges.size(); q++) {
+            if (q + ahead < ranges.size()) {
+                auto [l, r] = ranges[q + ahead];
+                size_t lEnd = min(r, l - l % BLOCK + BLOCK - 1);
+                __builtin_prefetch(&mask[r]);
+                __builtin_prefetch(&mask[lEnd]);
+                __builtin_prefetch(&values[r]);
+                __builtin_prefetch(&values[lEnd]);
+            }
+            results[q] = query(ranges[q].first, ranges[q].second);
+        }
+        return results;
+    }
+
+    size_t bytes() const {
+        return values.size() * sizeof(T) + mask.size() * sizeof(uint32_t) + blocks.bytes();
     }
 };
 
@@ -29,10 +175,40 @@ int main() {
     // Feature array (e.g., color histogram values)
     vector<int> features = {4, 2, 3, 7, 1, 5, 3, 3, 9, 2};
     SparseTable st(features);
-    
+
     // Query max feature in range (e.g., dominant color in region)
-    cout << "Dominant feature value in range [2,7]: " 
+    cout << "Dominant feature value in range [2,7]: "
          << st.query(2, 7) << endl;
+
+    // Same table shape, other idempotent operations
+    SparseTable<int, MinOp<int>> dimmest(features);
+    SparseTable<int, GcdOp<int>> commonStep({12, 18, 24, 36, 6, 30});
+    SparseTable<unsigned, AndOp<unsigned>> sharedBits({0b1110, 0b0111, 0b0110, 0b1111});
+    cout << "Dimmest feature in range [0,4]: " << dimmest.query(0, 4) << endl;
+    cout << "Common quantization step in [0,3]: " << commonStep.query(0, 3) << endl;
+    cout << "Channel bits shared by [0,2]: " << sharedBits.query(0, 2) << endl;
+
+    // Large histogram: full table vs O(n) block table, batched random queries
+    const size_t n = 1 << 22, queries = 1 << 22;
+    mt19937_64 rng(42);
+    vector<int> histogram(n);
+    for (auto& v : histogram) v = static_cast<int>(rng() % 1000000);
+    vector<pair<size_t, size_t>> ranges(queries);
+    for (auto& [l, r] : ranges) {
+        l = rng() % n;
+        r = l + rng() % (n - l);
+    }
+
+    auto timeBatch = [&](const char* label, const auto& table) {
+        auto start = chrono::steady_clock::now();
+        auto results = table.queryBatch(ranges);
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        long long check = accumulate(results.begin(), results.end(), 0LL);
+        cout << label << ": " << table.bytes() / (1 << 20) << " MiB, "
+             << queries << " queries in " << ms << " ms (checksum " << check << ")" << endl;
+    };
+    timeBatch("Sparse table      ", SparseTable<int>(histogram));
+    timeBatch("Block sparse table", BlockSparseTable<int>(histogram));
     return 0;
 }
 
@@ -41,4 +217,7 @@ int main() {
  * - Enables O(1) queries for dominant style features (e.g., max color intensity).
  * - Eliminates redundant processing during moodboard assembly.
  * - Reduces feature extraction time from O(P) to O(1) per query.
- */
\ No newline at end of file
+ * - Works for any idempotent feature operation (max, min, gcd, bitwise and)
+ *   with contiguous per-level storage and integer logs.
+ * - Scales to billion-element histograms with the O(n)-memory block table.
+ */
@@ -0,0 +1,293 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <string_view>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <random>
+#include <cstring>
+#include <cstdint>
+#include <stdexcept>
+
+// Problem: Decision threads read metrics while ingest threads rewrite them,
+// and a global lock makes every read wait behind every write
+// Solution: Sharded table with per-row seqlocks. Readers never lock: a single
+// metric is one atomic load, and a whole row is a consistent retry-on-change
+// copy. Writers batch updates per shard, taking each shard lock once.
+
+class ConcurrentContentMetrics {
+public:
+    using Column = uint32_t;
+
+    struct Update {
+        std::string content_id;
+        Column column;
+        double value;
+    };
+
+    // The attribute schema is fixed up front so rows can be flat arrays
+    ConcurrentContentMetrics(const std::vector<std::string>& attributes,
+                             size_t shard_count = 16, size_t rows_per_shard = 1 << 16)
+        : attribute_names(attributes), width(attributes.size()), shard_count(shard_count) {
+        for (Column c = 0; c < width; ++c) column_ids.emplace(attributes[c], c);
+        shards.reserve(shard_count);
+        for (size_t s = 0; s < shard_count; ++s)
+            shards.push_back(std::make_unique<Shard>(rows_per_shard, width));
+    }
+
+    Column column(const std::string& attribute) const { return column_ids.at(attribute); }
+
+    // Wait-free read of one metric; never blocks on writers
+    std::optional<double> get_metric(const std::string& content_id, Column col) const {
+        const Shard& shard = shard_for(content_id);
+        uint32_t row = shard.find(content_id);
+        if (row == NONE) return std::nullopt;
+        uint64_t bits = shard.cells[row * width + col].load(std::memory_order_acquire);
+        if (bits == MISSING_BITS) return std::nullopt;
+        return from_bits(bits);
+    }
+
+    // Consistent copy of every attribute of one row (seqlock read)
+    bool read_row(const std::string& content_id, std::vector<double>& out) const {
+        const Shard& shard = shard_for(content_id);
+        uint32_t row = shard.find(content_id);
+        if (row == NONE) return false;
+        out.resize(width);
+        const auto& seq = shard.sequence[row];
+        while (true) {
+            uint32_t before = seq.load(std::memory_order_acquire);
+            if (before & 1) { // Writer mid-update
+                std::this_thread::yield();
+                continue;
+            }
+            for (Column c = 0; c < width; ++c)
+                out[c] = from_bits(shard.cells[row * width + c].load(std::memory_order_relaxed));
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (seq.load(std::memory_order_relaxed) == before) return true;
+        }
+    }
+
+    void update_metric(const std::string& content_id, Column col, double value) {
+        apply({{content_id, col, value}});
+    }
+
+    // Applies a batch, taking each touched shard's writer lock once. All or
+    // nothing: the touched shards are locked in index order and checked for
+    // room first, so a batch that would overflow one throws before any write.
+    void apply(const std::vector<Update>& batch) {
+        std::vector<std::vector<const Update*>> by_shard(shard_count);
+        for (const auto& u : batch) by_shard[shard_index(u.content_id)].push_back(&u);
+
+        std::vector<std::unique_lock<std::mutex>> guards;
+        std::unordered_set<std::string_view> new_keys;
+        for (size_t s = 0; s < shard_count; ++s) {
+            if (by_shard[s].empty()) continue;
+            Shard& shard = *shards[s];
+            guards.emplace_back(shard.writer);
+            new_keys.clear();
+            for (const Update* u : by_shard[s])
+                if (shard.find(u->content_id) == NONE) new_keys.insert(u->content_id);
+            if (shard.used + new_keys.size() > shard.capacity) throw std::length_error("metrics shard is full");
+        }
+
+        for (size_t s = 0; s < shard_count; ++s) {
+            Shard& shard = *shards[s];
+            for (const Update* u : by_shard[s]) {
+                uint32_t row = shard.find_or_insert(u->content_id);
+                auto& seq = shard.sequence[row];
+                uint32_t v = seq.load(std::memory_order_relaxed);
+                seq.store(v + 1, std::memory_order_relaxed); // Odd: row is changing
+                std::atomic_thread_fence(std::memory_order_release);
+                shard.cells[row * width + u->column].store(to_bits(u->value), std::memory_order_release);
+                seq.store(v + 2, std::memory_order_release);
+            }
+        }
+    }
+
+    const std::vector<std::string>& attributes() const { return attribute_names; }
+
+private:
+    static constexpr uint32_t NONE = UINT32_MAX;
+    static constexpr uint64_t MISSING_BITS = 0x7FF8DEADBEEF0001ULL; // A NaN payload
+
+    static uint64_t to_bits(double v) { uint64_t b; std::memcpy(&b, &v, sizeof b); return b; }
+    static double from_bits(uint64_t b) { double v; std::memcpy(&v, &b, sizeof v); return v; }
+
+    struct Shard {
+        // Row directory: open addressing, slots published once with release
+        struct Slot {
+            std::atomic<uint32_t> row{NONE};
+            std::string key;
+        };
+
+        std::mutex writer;                            // Writers only
+        std::unique_ptr<Slot[]> slots;
+        size_t slot_mask;
+        std::unique_ptr<std::atomic<uint32_t>[]> sequence; // Per-row seqlock
+        std::unique_ptr<std::atomic<uint64_t>[]> cells;    // rows x width, row-major
+        size_t capacity;
+        size_t width;
+        uint32_t used = 0;                            // Guarded by writer
+
+        Shard(size_t capacity, size_t width) : capacity(capacity), width(width) {
+            size_t table = 1;
+            while (table < 2 * capacity) table <<= 1;
+            slot_mask = table - 1;
+            slots = std::make_unique<Slot[]>(table);
+            sequence = std::make_unique<std::atomic<uint32_t>[]>(capacity);
+            cells = std::make_unique<std::atomic<uint64_t>[]>(capacity * width);
+            for (size_t i = 0; i < capacity * width; ++i) cells[i].store(MISSING_BITS, std::memory_order_relaxed);
+        }
+
+        uint32_t find(const std::string& key) const {
+            size_t i = std::hash<std::string>{}(key) & slot_mask;
+            while (true) {
+                uint32_t row = slots[i].row.load(std::memory_order_acquire);
+                if (row == NONE) return NONE;
+                if (slots[i].key == key) return row;
+                i = (i + 1) & slot_mask;
+            }
+        }
+
+        // Caller holds `writer`
+        uint32_t find_or_insert(const std::string& key) {
+            size_t i = std::hash<std::string>{}(key) & slot_mask;
+            while (true) {
+                uint32_t row = slots[i].row.load(std::memory_order_relaxed);
+                if (row == NONE) {
+                    if (used == capacity) throw std::length_error("metrics shard is full");
+                    slots[i].key = key;
+                    slots[i].row.store(used, std::memory_order_release); // Key visible first
+                    return used++;
+                }
+                if (slots[i].key == key) return row;
+                i = (i + 1) & slot_mask;
+            }
+        }
+    };
+
+    size_t shard_index(const std::string& content_id) const {
+        return (std::hash<std::string>{}(content_id) >> 7) % shard_count;
+    }
+    const Shard& shard_for(const std::string& content_id) const { return *shards[shard_index(content_id)]; }
+
+    std::vector<std::string> attribute_names;
+    std::unordered_map<std::string, Column> column_ids;
+    size_t width;
+    size_t shard_count;
+    std::vector<std::unique_ptr<Shard>> shards;
+};
+
+// Baseline for the benchmark: the same table behind one global mutex
+class LockedContentMetrics {
+public:
+    std::optional<double> get_metric(const std::string& content_id, uint32_t col) {
+        std::lock_guard<std::mutex> guard(lock);
+        auto it = rows.find(content_id);
+        if (it == rows.end() || it->second.size() <= col) return std::nullopt;
+        return it->second[col];
+    }
+    void apply(const std::vector<ConcurrentContentMetrics::Update>& batch) {
+        std::lock_guard<std::mutex> guard(lock);
+        for (const auto& u : batch) {
+            auto& row = rows[u.content_id];
+            if (row.size() <= u.column) row.resize(u.column + 1);
+            row[u.column] = u.value;
+        }
+    }
+private:
+    std::mutex lock;
+    std::unordered_map<std::string, std::vector<double>> rows;
+};
+
+// Readers time every get_metric while writers stream batches nonstop. The
+// mutex tail only shows when readers and writers truly run in parallel.
+template <typename Table>
+static void benchmark_reads(const char* label, Table& table, int readers, int writers) {
+    const int articles = 10000, reads_per_thread = 200000;
+    std::vector<std::string> ids;
+    for (int i = 0; i < articles; ++i) ids.push_back("article" + std::to_string(i));
+
+    std::atomic<bool> stop{false};
+    std::vector<std::thread> writer_threads;
+    for (int w = 0; w < writers; ++w) {
+        writer_threads.emplace_back([&, w]() {
+            std::mt19937 rng(w + 1);
+            std::vector<ConcurrentContentMetrics::Update> batch;
+            while (!stop.load(std::memory_order_relaxed)) {
+                batch.clear();
+                for (int i = 0; i < 64; ++i)
+                    batch.push_back({ids[rng() % articles], static_cast<uint32_t>(rng() % 3), (rng() % 1000) / 1000.0});
+                table.apply(batch);
+            }
+        });
+    }
+
+    std::vector<std::vector<uint32_t>> latencies(readers);
+    std::vector<std::thread> reader_threads;
+    for (int r = 0; r < readers; ++r) {
+        reader_threads.emplace_back([&, r]() {
+            std::mt19937 rng(100 + r);
+            auto& samples = latencies[r];
+            samples.reserve(reads_per_thread);
+            double sink = 0;
+            for (int i = 0; i < reads_per_thread; ++i) {
+                const std::string& id = ids[rng() % articles];
+                auto start = std::chrono::steady_clock::now();
+                auto value = table.get_metric(id, 0);
+                auto end = std::chrono::steady_clock::now();
+                sink += value.value_or(0);
+                samples.push_back(static_cast<uint32_t>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()));
+            }
+            if (sink < 0) std::cout << sink; // Keep the reads observable
+        });
+    }
+    for (auto& t : reader_threads) t.join();
+    stop = true;
+    for (auto& t : writer_threads) t.join();
+
+    std::vector<uint32_t> all;
+    for (auto& s : latencies) all.insert(all.end(), s.begin(), s.end());
+    auto pct = [&](double p) {
+        size_t k = static_cast<size_t>(p * (all.size() - 1));
+        std::nth_element(all.begin(), all.begin() + k, all.end());
+        return all[k];
+    };
+    std::cout << std::setw(22) << label << "  p50 " << std::setw(6) << pct(0.50)
+              << " ns   p99 " << std::setw(8) << pct(0.99)
+              << " ns   p99.9 " << std::setw(9) << pct(0.999) << " ns\n";
+}
+
+int main() {
+    ConcurrentContentMetrics analytics({"click_rate", "read_time", "shares"});
+    auto click_rate = analytics.column("click_rate");
+    auto read_time = analytics.column("read_time");
+
+    // Ingest batches per shard; decision threads read without locks
+    analytics.apply({{"article123", click_rate, 0.15},
+                     {"article123", read_time, 45.2},
+                     {"article456", click_rate, 0.22}});
+    std::cout << "article456 click rate: " << analytics.get_metric("article456", click_rate).value_or(0) << "\n";
+
+    std::vector<double> row;
+    if (analytics.read_row("article123", row))
+        std::cout << "article123 consistent row: " << row[0] << ", " << row[1] << "\n";
+
+    // p99 read latency under heavy write load
+    std::cout << "\nRead latency with 2 readers, 2 writers:\n";
+    ConcurrentContentMetrics seqlocked({"click_rate", "read_time", "shares"});
+    LockedContentMetrics locked;
+    benchmark_reads("seqlock rows", seqlocked, 2, 2);
+    benchmark_reads("global mutex", locked, 2, 2);
+
+    return 0;
+}
@@ -1,55 +1,323 @@
 #include <iostream>
-#include <queue>
 #include <vector>
 #include <string>
+#include <unordered_map>
+#include <algorithm>
+#include <cstdint>
+#include <atomic>
+#include <memory>
+#include <queue>
+#include <thread>
 #include <utility>
+#include <deque>
 
 // Problem: Delays in ranking prevent timely promotion of top content
-// Solution: Max-heap maintains dynamic leaderboard with O(logN) updates
+// Solution: Indexed 4-ary max-heap keeps one entry per article with O(logN)
+// score updates, and top-k walks only the top of the heap instead of copying it
 
 class ContentRanker {
 public:
     void add_content(const std::string& id, double score) {
-        ranking.emplace(score, id);
+        auto [it, inserted] = ids.emplace(id, static_cast<uint32_t>(names.size()));
+        if (!inserted) {
+            update_score(id, score);
+            return;
+        }
+        names.push_back(id);
+        position.push_back(static_cast<uint32_t>(heap.size()));
+        heap.push_back({score, it->second});
+        sift_up(heap.size() - 1);
     }
-    
+
+    // Moves the article's single heap entry in place: O(logN), no duplicates
     void update_score(const std::string& id, double new_score) {
-        // In a real system, we'd need a more sophisticated update mechanism
-        // This simplified version just pushes the new score
-        add_content(id, new_score);
+        auto it = ids.find(id);
+        if (it == ids.end()) {
+            add_content(id, new_score);
+            return;
+        }
+        size_t slot = position[it->second];
+        double old_score = heap[slot].score;
+        heap[slot].score = new_score;
+        if (new_score > old_score) sift_up(slot);
+        else sift_down(slot);
     }
-    
-    std::vector<std::string> get_top_k(int k) {
+
+    // Best-first walk from the root: the next best article is always a child
+    // of one already taken, so only O(k) heap slots are touched in O(k logk)
+    std::vector<std::string> get_top_k(int k) const {
         std::vector<std::string> result;
-        auto temp = ranking;
-        
-        while (!temp.empty() && result.size() < k) {
-            result.push_back(temp.top().second);
-            temp.pop();
+        visit_top_k(k, [&](const std::string& id, double) { result.push_back(id); });
+        return result;
+    }
+
+    std::vector<std::pair<double, std::string>> get_top_k_with_scores(int k) const {
+        std::vector<std::pair<double, std::string>> result;
+        visit_top_k(k, [&](const std::string& id, double score) { result.emplace_back(score, id); });
+        return result;
+    }
+
+    size_t size() const { return heap.size(); }
+
+private:
+    static constexpr size_t ARITY = 4; // Shallower than binary; children share a cache line
+
+    struct Entry {
+        double score;
+        uint32_t id; // Interned content ID
+    };
+
+    template <typename Visit>
+    void visit_top_k(int k, Visit visit) const {
+        if (heap.empty() || k <= 0) return;
+        auto lower = [this](uint32_t a, uint32_t b) { return heap[a].score < heap[b].score; };
+        // Local, so concurrent readers of a const ranker share nothing mutable
+        std::vector<uint32_t> frontier;
+        // Never more than k pops can run, and never more than the heap holds
+        frontier.reserve((ARITY - 1) * std::min(static_cast<size_t>(k), heap.size()) + 1);
+        frontier.push_back(0);
+        for (int taken = 0; !frontier.empty() && taken < k; ++taken) {
+            std::pop_heap(frontier.begin(), frontier.end(), lower);
+            uint32_t slot = frontier.back();
+            frontier.pop_back();
+            visit(names[heap[slot].id], heap[slot].score);
+            size_t first_child = ARITY * slot + 1;
+            for (size_t c = first_child; c < first_child + ARITY && c < heap.size(); ++c) {
+                frontier.push_back(static_cast<uint32_t>(c));
+                std::push_heap(frontier.begin(), frontier.end(), lower);
+            }
+        }
+    }
+
+    void place(size_t slot, const Entry& entry) {
+        heap[slot] = entry;
+        position[entry.id] = static_cast<uint32_t>(slot);
+    }
+
+    void sift_up(size_t slot) {
+        Entry moving = heap[slot];
+        while (slot > 0) {
+            size_t parent = (slot - 1) / ARITY;
+            if (heap[parent].score >= moving.score) break;
+            place(slot, heap[parent]);
+            slot = parent;
+        }
+        place(slot, moving);
+    }
+
+    void sift_down(size_t slot) {
+        Entry moving = heap[slot];
+        while (true) {
+            size_t first_child = ARITY * slot + 1;
+            if (first_child >= heap.size()) break;
+            size_t best = first_child;
+            size_t last_child = std::min(first_child + ARITY, heap.size());
+            for (size_t c = first_child + 1; c < last_child; ++c)
+                if (heap[c].score > heap[best].score) best = c;
+            if (heap[best].score <= moving.score) break;
+            place(slot, heap[best]);
+            slot = best;
+        }
+        place(slot, moving);
+    }
+
+    std::unordered_map<std::string, uint32_t> ids; // Content ID -> dense index
+    std::vector<std::string> names;                // Dense index -> content ID
+    std::vector<uint32_t> position;                // Dense index -> heap slot
+    std::vector<Entry> heap;                       // Max-heap on score
+};
+
+// Epoch-based reclamation: readers announce the epoch they entered in, and a
+// retired snapshot is freed only once every active reader entered after it
+// was unpublished. Writers never wait for readers.
+class EpochManager {
+public:
+    static constexpr size_t MAX_READERS = 64; // Guards alive at once, not threads ever
+
+private:
+    struct alignas(64) ReaderSlot {
+        std::atomic<uint64_t> epoch{0}; // 0 = not reading
+        std::atomic<bool> claimed{false};
+    };
+
+public:
+    class Guard {
+    public:
+        explicit Guard(ReaderSlot& slot) : slot(slot) {}
+        ~Guard() {
+            slot.epoch.store(0, std::memory_order_release);
+            slot.claimed.store(false, std::memory_order_release);
+        }
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+    private:
+        ReaderSlot& slot;
+    };
+
+    // Every guard, nested ones included, holds its own slot of this manager
+    // and hands it back when it ends, so thread churn never exhausts slots.
+    // Each thread starts from the slot it used last, which is usually free,
+    // so entering is one uncontended CAS on a line no other thread touches.
+    Guard enter() {
+        thread_local size_t hint = std::hash<std::thread::id>{}(std::this_thread::get_id());
+        while (true) {
+            for (size_t i = 0; i < MAX_READERS; ++i) {
+                size_t index = (hint + i) % MAX_READERS;
+                ReaderSlot& slot = readers[index];
+                bool expected = false;
+                if (slot.claimed.load(std::memory_order_relaxed) ||
+                    !slot.claimed.compare_exchange_strong(expected, true, std::memory_order_acquire))
+                    continue;
+                hint = index;
+                slot.epoch.store(global_epoch.load(), std::memory_order_seq_cst);
+                return Guard(slot);
+            }
+            std::this_thread::yield(); // All MAX_READERS slots are in use right now
+        }
+    }
+
+    // Call right after unpublishing; returns the epoch the object retires in
+    uint64_t advance() { return global_epoch.fetch_add(1); }
+
+    // True once no reader can still hold an object retired in `epoch`
+    bool is_safe(uint64_t epoch) const {
+        for (const auto& r : readers) {
+            uint64_t active = r.epoch.load(std::memory_order_seq_cst);
+            if (active != 0 && active <= epoch) return false;
+        }
+        return true;
+    }
+
+private:
+    std::atomic<uint64_t> global_epoch{1};
+    ReaderSlot readers[MAX_READERS];
+};
+
+// Leaderboard partitioned across ingest threads. Each shard is written by one
+// thread into its own ContentRanker and periodically publishes an immutable,
+// sorted prefix of it. The global top-k is a k-way heap merge of those
+// prefixes: O(shards + k log(shards)), independent of the article count.
+class ShardedRanker {
+    struct Snapshot {
+        std::vector<std::pair<double, std::string>> top; // Best first
+    };
+
+public:
+    class Shard {
+    public:
+        void add_content(const std::string& id, double score) { local.add_content(id, score); }
+        void update_score(const std::string& id, double new_score) { local.update_score(id, new_score); }
+
+        // Makes the current local ranking visible to readers
+        void publish() {
+            auto* fresh = new Snapshot{local.get_top_k_with_scores(static_cast<int>(prefix))};
+            const Snapshot* old = published.exchange(fresh, std::memory_order_seq_cst);
+            if (old) retired.emplace_back(epochs->advance(), old);
+            while (!retired.empty() && epochs->is_safe(retired.front().first)) {
+                delete retired.front().second;
+                retired.pop_front();
+            }
+        }
+
+        ~Shard() {
+            delete published.load();
+            for (auto& [epoch, snapshot] : retired) delete snapshot;
+        }
+
+    private:
+        friend class ShardedRanker;
+        ContentRanker local;
+        size_t prefix = 0;
+        EpochManager* epochs = nullptr;
+        std::atomic<const Snapshot*> published{nullptr};
+        std::deque<std::pair<uint64_t, const Snapshot*>> retired;
+    };
+
+    // published_prefix bounds the largest k a global query can answer
+    ShardedRanker(size_t shard_count, size_t published_prefix = 100)
+        : shards(std::make_unique<Shard[]>(shard_count)), shard_count(shard_count) {
+        for (size_t i = 0; i < shard_count; ++i) {
+            shards[i].prefix = published_prefix;
+            shards[i].epochs = &epochs;
+        }
+    }
+
+    // Owned by a single ingest thread
+    Shard& shard(size_t i) { return shards[i]; }
+
+    // Safe from any thread; never blocks writers
+    std::vector<std::pair<double, std::string>> get_top_k(size_t k) {
+        auto guard = epochs.enter();
+        std::vector<const Snapshot*> views(shard_count);
+        using Cursor = std::pair<double, std::pair<size_t, size_t>>; // (score, (shard, index))
+        std::priority_queue<Cursor> heads;
+        for (size_t s = 0; s < shard_count; ++s) {
+            views[s] = shards[s].published.load(std::memory_order_seq_cst);
+            if (views[s] && !views[s]->top.empty()) heads.push({views[s]->top[0].first, {s, 0}});
+        }
+
+        std::vector<std::pair<double, std::string>> result;
+        while (!heads.empty() && result.size() < k) {
+            auto [s, i] = heads.top().second;
+            heads.pop();
+            result.push_back(views[s]->top[i]);
+            if (i + 1 < views[s]->top.size()) heads.push({views[s]->top[i + 1].first, {s, i + 1}});
         }
         return result;
     }
 
 private:
-    // Max-heap based on score
-    std::priority_queue<std::pair<double, std::string>> ranking;
+    EpochManager epochs;
+    std::unique_ptr<Shard[]> shards;
+    size_t shard_count;
 };
 
 int main() {
     ContentRanker ranker;
-    
+
     // Simulate real-time score updates
     ranker.add_content("article1", 45.2);
     ranker.add_content("article2", 78.9);
     ranker.add_content("article3", 32.1);
     ranker.update_score("article1", 50.5); // Article gets more engagement
-    
-    // Get current top performers in O(k logN) time
+    ranker.update_score("article2", 12.0); // Engagement on article2 collapses
+
+    // Get current top performers in O(k logk) time
     auto top = ranker.get_top_k(2);
     std::cout << "Top performing articles:\n";
     for (const auto& id : top) {
         std::cout << id << "\n";
     }
-    
+
+    // Each ingest thread owns one shard; a dashboard thread reads concurrently
+    ShardedRanker global(4, 10);
+    std::vector<std::thread> ingest;
+    for (size_t s = 0; s < 4; ++s) {
+        ingest.emplace_back([&global, s]() {
+            auto& shard = global.shard(s);
+            for (int i = 0; i < 2000; ++i) {
+                std::string id = "shard" + std::to_string(s) + "_article" + std::to_string(i % 50);
+                shard.update_score(id, (i * 37 + s * 11) % 1000 / 10.0);
+                if (i % 100 == 99) shard.publish();
+            }
+        });
+    }
+    std::thread dashboard([&global]() {
+        for (int i = 0; i < 200; ++i) global.get_top_k(5);
+    });
+    // Short-lived request threads come and go; their reader slots are reused
+    for (int wave = 0; wave < 50; ++wave) {
+        std::vector<std::thread> requests;
+        for (int r = 0; r < 4; ++r) requests.emplace_back([&global]() { global.get_top_k(3); });
+        for (auto& t : requests) t.join();
+    }
+    for (auto& t : ingest) t.join();
+    dashboard.join();
+
+    std::cout << "Global top performers across shards:\n";
+    for (const auto& [score, id] : global.get_top_k(3)) {
+        std::cout << id << " (" << score << ")\n";
+    }
+
     return 0;
-}
\ No newline at end of file
+}
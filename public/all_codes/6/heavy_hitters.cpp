@@ -0,0 +1,305 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <thread>
+
+// Problem: Trending leaderboards must rank an unbounded engagement stream,
+// but exact per-article counts grow without limit
+// Solution: Space-Saving keeps m counters in a stream-summary (O(1) per event,
+// overestimate <= N/m), and a conservative-update Count-Min sketch filters
+// one-off articles before they can evict a real heavy hitter
+
+// Count-Min sketch with conservative update: estimates never undercount and
+// exceed the true count by at most epsilon*N with probability 1 - delta
+class CountMinSketch {
+public:
+    CountMinSketch(double epsilon, double delta)
+        : width(static_cast<size_t>(std::ceil(std::exp(1.0) / epsilon))),
+          depth(static_cast<size_t>(std::ceil(std::log(1.0 / delta)))),
+          cells(width * depth, 0) {}
+
+    // Raises only the rows sitting at the current minimum
+    uint64_t add(uint64_t key_hash) {
+        uint64_t estimate = UINT64_MAX;
+        for (size_t row = 0; row < depth; ++row)
+            estimate = std::min(estimate, cells[index(row, key_hash)]);
+        ++estimate;
+        for (size_t row = 0; row < depth; ++row) {
+            uint64_t& cell = cells[index(row, key_hash)];
+            cell = std::max(cell, estimate);
+        }
+        return estimate;
+    }
+
+    uint64_t estimate(uint64_t key_hash) const {
+        uint64_t result = UINT64_MAX;
+        for (size_t row = 0; row < depth; ++row)
+            result = std::min(result, cells[index(row, key_hash)]);
+        return result;
+    }
+
+    // Cell-wise sum still upper-bounds every count of the combined stream
+    void merge(const CountMinSketch& other) {
+        for (size_t i = 0; i < cells.size(); ++i) cells[i] += other.cells[i];
+    }
+
+private:
+    size_t index(size_t row, uint64_t key_hash) const {
+        uint64_t h = (key_hash + row * 0x9E3779B97F4A7C15ULL) * 0xBF58476D1CE4E5B9ULL;
+        return row * width + static_cast<size_t>((h ^ (h >> 31)) % width);
+    }
+
+    size_t width, depth;
+    std::vector<uint64_t> cells;
+};
+
+class HeavyHitters {
+public:
+    struct Hitter {
+        std::string id;
+        uint64_t count;       // Upper bound on the true count
+        uint64_t guaranteed;  // Lower bound on the true count
+    };
+
+    // capacity = counters kept (overestimate <= N / capacity);
+    // epsilon, delta size the Count-Min filter
+    explicit HeavyHitters(size_t capacity, double epsilon = 1e-4, double delta = 1e-3)
+        : capacity(capacity), sketch(epsilon, delta) {
+        counters.reserve(capacity);
+        buckets.reserve(capacity + 1);
+        index.reserve(capacity);
+    }
+
+    // O(1) amortized per engagement event
+    void observe(const std::string& id) {
+        ++stream_length;
+        uint64_t key_hash = std::hash<std::string>{}(id);
+        uint64_t sketch_estimate = sketch.add(key_hash);
+
+        auto it = index.find(id);
+        if (it != index.end()) {
+            increment(it->second);
+            return;
+        }
+        if (counters.size() < capacity) {
+            uint32_t c = static_cast<uint32_t>(counters.size());
+            counters.push_back({id, 0, NIL, NIL, NIL});
+            index.emplace(id, c);
+            attach(c, 1);
+            return;
+        }
+        // Evict the smallest counter only if the sketch says this article has
+        // genuinely outgrown it; the sketch never undercounts, so skipped
+        // articles still respect the Space-Saving bound of min_count
+        uint64_t min_count = buckets[min_bucket].count;
+        if (sketch_estimate <= min_count) return;
+
+        uint32_t victim = buckets[min_bucket].first;
+        index.erase(counters[victim].id);
+        counters[victim].id = id;
+        counters[victim].error = min_count;
+        index.emplace(id, victim);
+        increment(victim);
+    }
+
+    // Upper bound on an article's count, monitored or not
+    uint64_t estimate(const std::string& id) const {
+        uint64_t from_sketch = sketch.estimate(std::hash<std::string>{}(id));
+        auto it = index.find(id);
+        if (it != index.end())
+            return std::min(from_sketch, buckets[counters[it->second].bucket].count);
+        uint64_t floor = counters.size() < capacity ? 0 : buckets[min_bucket].count;
+        return std::min(from_sketch, floor);
+    }
+
+    // Largest counters first, walking the stream-summary from the top
+    std::vector<Hitter> top_k(size_t k) const {
+        std::vector<Hitter> result;
+        for (uint32_t b = max_bucket; b != NIL && result.size() < k; b = buckets[b].prev) {
+            for (uint32_t c = buckets[b].first; c != NIL && result.size() < k; c = counters[c].next) {
+                uint64_t upper = std::min(buckets[b].count, sketch.estimate(std::hash<std::string>{}(counters[c].id)));
+                result.push_back({counters[c].id, upper, buckets[b].count - counters[c].error});
+            }
+        }
+        return result;
+    }
+
+    // Combines a per-thread instance into this one (mergeable summaries):
+    // absent keys are charged the other side's minimum, then the largest
+    // `capacity` counters are kept
+    void merge(const HeavyHitters& other) {
+        struct Merged { std::string id; uint64_t count, error; };
+        uint64_t my_min = counters.size() < capacity ? 0 : buckets[min_bucket].count;
+        uint64_t other_min = other.counters.size() < other.capacity ? 0 : other.buckets[other.min_bucket].count;
+
+        std::unordered_map<std::string, Merged> combined;
+        for (const auto& [id, c] : index)
+            combined[id] = {id, buckets[counters[c].bucket].count + other_min, counters[c].error + other_min};
+        for (const auto& [id, c] : other.index) {
+            uint64_t count = other.buckets[other.counters[c].bucket].count;
+            uint64_t error = other.counters[c].error;
+            auto it = combined.find(id);
+            if (it == combined.end()) {
+                combined[id] = {id, count + my_min, error + my_min};
+            } else {
+                it->second.count += count - other_min;
+                it->second.error += error - other_min;
+            }
+        }
+
+        std::vector<Merged> ranked;
+        ranked.reserve(combined.size());
+        for (auto& [id, m] : combined) ranked.push_back(std::move(m));
+        std::sort(ranked.begin(), ranked.end(), [](const Merged& a, const Merged& b) { return a.count < b.count; });
+        if (ranked.size() > capacity) ranked.erase(ranked.begin(), ranked.end() - capacity);
+
+        counters.clear();
+        buckets.clear();
+        free_buckets.clear();
+        index.clear();
+        min_bucket = max_bucket = NIL;
+        for (auto& m : ranked) { // Ascending counts, so each lands at the tail
+            uint32_t c = static_cast<uint32_t>(counters.size());
+            counters.push_back({m.id, m.error, NIL, NIL, NIL});
+            index.emplace(std::move(m.id), c);
+            attach(c, m.count);
+        }
+        sketch.merge(other.sketch);
+        stream_length += other.stream_length;
+    }
+
+    uint64_t events() const { return stream_length; }
+    uint64_t error_bound() const { return stream_length / capacity; }
+
+private:
+    static constexpr uint32_t NIL = UINT32_MAX;
+
+    // Stream-summary: buckets of equal count in ascending order, each holding
+    // a list of counters, so a +1 moves a counter to the neighbouring bucket
+    struct Bucket {
+        uint64_t count;
+        uint32_t first;      // First counter in this bucket
+        uint32_t prev, next; // Neighbouring buckets
+    };
+    struct Counter {
+        std::string id;
+        uint64_t error;      // Possible overcount inherited on eviction
+        uint32_t bucket;
+        uint32_t prev, next; // Neighbours within the bucket
+    };
+
+    uint32_t new_bucket(uint64_t count, uint32_t prev, uint32_t next) {
+        uint32_t b;
+        if (!free_buckets.empty()) {
+            b = free_buckets.back();
+            free_buckets.pop_back();
+        } else {
+            b = static_cast<uint32_t>(buckets.size());
+            buckets.push_back({});
+        }
+        buckets[b] = {count, NIL, prev, next};
+        if (prev != NIL) buckets[prev].next = b; else min_bucket = b;
+        if (next != NIL) buckets[next].prev = b; else max_bucket = b;
+        return b;
+    }
+
+    void link_into(uint32_t c, uint32_t b) {
+        counters[c].bucket = b;
+        counters[c].prev = NIL;
+        counters[c].next = buckets[b].first;
+        if (buckets[b].first != NIL) counters[buckets[b].first].prev = c;
+        buckets[b].first = c;
+    }
+
+    // Unlinks c from its bucket, freeing the bucket if it empties
+    void unlink(uint32_t c) {
+        uint32_t b = counters[c].bucket;
+        if (counters[c].prev != NIL) counters[counters[c].prev].next = counters[c].next;
+        else buckets[b].first = counters[c].next;
+        if (counters[c].next != NIL) counters[counters[c].next].prev = counters[c].prev;
+        if (buckets[b].first != NIL) return;
+
+        uint32_t prev = buckets[b].prev, next = buckets[b].next;
+        if (prev != NIL) buckets[prev].next = next; else min_bucket = next;
+        if (next != NIL) buckets[next].prev = prev; else max_bucket = prev;
+        free_buckets.push_back(b);
+    }
+
+    // Appends a fresh counter with the given count (count >= current max or
+    // count == 1 while filling), keeping buckets sorted
+    void attach(uint32_t c, uint64_t count) {
+        if (max_bucket != NIL && buckets[max_bucket].count == count) {
+            link_into(c, max_bucket);
+        } else if (min_bucket != NIL && buckets[min_bucket].count == count) {
+            link_into(c, min_bucket);
+        } else if (min_bucket == NIL || count > buckets[max_bucket].count) {
+            link_into(c, new_bucket(count, max_bucket, NIL));
+        } else {
+            link_into(c, new_bucket(count, NIL, min_bucket)); // count below every bucket
+        }
+    }
+
+    void increment(uint32_t c) {
+        uint32_t b = counters[c].bucket;
+        uint64_t target = buckets[b].count + 1;
+        uint32_t next = buckets[b].next;
+
+        // Alone in its bucket and no bucket at count+1: bump the bucket itself
+        if (buckets[b].first == c && counters[c].next == NIL && (next == NIL || buckets[next].count != target)) {
+            buckets[b].count = target;
+            return;
+        }
+        unlink(c);
+        if (next != NIL && buckets[next].count == target) {
+            link_into(c, next);
+        } else {
+            // The old bucket still exists here (c had company), insert after it
+            link_into(c, new_bucket(target, b, next));
+        }
+    }
+
+    size_t capacity;
+    CountMinSketch sketch;
+    std::vector<Counter> counters;
+    std::vector<Bucket> buckets;
+    std::vector<uint32_t> free_buckets;
+    std::unordered_map<std::string, uint32_t> index;
+    uint32_t min_bucket = NIL, max_bucket = NIL;
+    uint64_t stream_length = 0;
+};
+
+int main() {
+    // Engagement events follow a heavy-tailed (Zipf-like) popularity curve
+    const int articles = 100000, threads = 4, events_per_thread = 250000;
+    std::vector<HeavyHitters> per_thread(threads, HeavyHitters(200));
+
+    // Each ingest thread owns its tracker: no sharing on the hot path
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t]() {
+            std::mt19937_64 rng(t + 1);
+            std::uniform_real_distribution<double> u(0.0, 1.0);
+            for (int i = 0; i < events_per_thread; ++i) {
+                int rank = static_cast<int>(std::pow(articles, u(rng))); // ~1/x popularity
+                per_thread[t].observe("article" + std::to_string(rank));
+            }
+        });
+    }
+    for (auto& w : workers) w.join();
+
+    HeavyHitters trending = per_thread[0];
+    for (int t = 1; t < threads; ++t) trending.merge(per_thread[t]);
+
+    std::cout << "Trending after " << trending.events() << " events (overcount <= "
+              << trending.error_bound() << "):\n";
+    for (const auto& hit : trending.top_k(5)) {
+        std::cout << hit.id << ": between " << hit.guaranteed << " and " << hit.count << "\n";
+    }
+
+    return 0;
+}
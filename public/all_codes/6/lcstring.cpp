@@ -1,6 +1,17 @@
 #include <iostream>
 #include <vector>
 #include <algorithm>
+#include <string>
+#include <utility>
+#include <cstdint>
+#include <unordered_map>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <random>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
 
 // Problem: Manual analysis of successful attributes is slow and unscalable
 // Solution: LCS automatically identifies common patterns in top-performing content
@@ -25,16 +36,307 @@ std::string longest_common_substring(const std::string& s1, const std::string& s
     return max_len ? s1.substr(end_pos - max_len, max_len) : "";
 }
 
+// Best match so far: the longest length, ties going to the earliest end in s1
+// (the cell the quadratic table above keeps)
+struct SubstringMatch {
+    size_t length = 0;
+    size_t end = 0; // One past the match's last character in s1
+
+    void offer(size_t len, size_t at) {
+        if (len > length || (len == length && len > 0 && at < end)) {
+            length = len;
+            end = at;
+        }
+    }
+};
+
+// One DP row: cur[k+1] = (cols[k] == c) ? prev[k] + 1 : 0 for k < width.
+// prev[0] / cur[0] hold the column left of the block. Returns the row max.
+static uint32_t lcs_row(const char* cols, size_t width, char c, const uint32_t* prev, uint32_t* cur) {
+    size_t k = 0;
+    uint32_t row_max = 0;
+#ifdef __AVX2__
+    // 8 bytes compared per step; cells only depend on the previous row
+    const __m256i needle = _mm256_set1_epi32(static_cast<unsigned char>(c));
+    const __m256i one = _mm256_set1_epi32(1);
+    __m256i best = _mm256_setzero_si256();
+    for (; k + 8 <= width; k += 8) {
+        __m128i bytes = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(cols + k));
+        __m256i eq = _mm256_cmpeq_epi32(_mm256_cvtepu8_epi32(bytes), needle);
+        __m256i diag = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(prev + k));
+        __m256i cell = _mm256_and_si256(eq, _mm256_add_epi32(diag, one));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(cur + k + 1), cell);
+        best = _mm256_max_epu32(best, cell);
+    }
+    alignas(32) uint32_t lanes[8];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), best);
+    row_max = *std::max_element(lanes, lanes + 8);
+#endif
+    for (; k < width; ++k) {
+        cur[k + 1] = cols[k] == c ? prev[k] + 1 : 0;
+        row_max = std::max(row_max, cur[k + 1]);
+    }
+    return row_max;
+}
+
+// Same answer as longest_common_substring() in O(min(m,n)) memory: two rows
+// over the shorter string, the longer one streamed past them
+std::string longest_common_substring_linear(const std::string& s1, const std::string& s2) {
+    bool s1_rows = s2.size() <= s1.size();
+    const std::string& rows = s1_rows ? s1 : s2;
+    const std::string& cols = s1_rows ? s2 : s1;
+    std::vector<uint32_t> prev(cols.size() + 1, 0), cur(cols.size() + 1, 0);
+    SubstringMatch best;
+
+    for (size_t r = 0; r < rows.size(); ++r) {
+        uint32_t row_max = lcs_row(cols.data(), cols.size(), rows[r], prev.data(), cur.data());
+        if (s1_rows) {
+            best.offer(row_max, r + 1); // Whole row ends at the same s1 position
+        } else if (row_max > 0 && row_max >= best.length) {
+            size_t k = std::find(cur.begin() + 1, cur.end(), row_max) - cur.begin();
+            best.offer(row_max, k); // Earliest s1 end in this row
+        }
+        std::swap(prev, cur);
+    }
+    return s1.substr(best.end - best.length, best.length);
+}
+
+// Parallel wavefront: the table is cut into tile x tile blocks, and every
+// block on one anti-diagonal only needs blocks from the two before it, so a
+// diagonal's blocks run concurrently. Blocks exchange just their boundary
+// row and column, so memory stays O(m + n) rather than O(m * n).
+std::string longest_common_substring_parallel(const std::string& s1, const std::string& s2,
+                                              unsigned threads = std::thread::hardware_concurrency(),
+                                              size_t tile = 1024) {
+    const size_t m = s1.size(), n = s2.size();
+    if (m == 0 || n == 0) return "";
+    threads = std::max(1u, threads);
+    const size_t tile_rows = (m + tile - 1) / tile, tile_cols = (n + tile - 1) / tile;
+
+    std::vector<uint32_t> bottom(n, 0); // Last row computed above, per column
+    std::vector<uint32_t> right(m, 0);  // Last column computed to the left, per row
+    // Corner cells dp[row0 - 1][col0 - 1], double-buffered by diagonal parity:
+    // a block saves the corner its right neighbour needs on the next diagonal
+    std::vector<uint32_t> corner[2] = {std::vector<uint32_t>(tile_cols + 1, 0), std::vector<uint32_t>(tile_cols + 1, 0)};
+    std::vector<SubstringMatch> found(threads);
+
+    auto run_block = [&](size_t a, size_t b, std::vector<uint32_t>& prev, std::vector<uint32_t>& cur, SubstringMatch& best) {
+        size_t row0 = a * tile, row1 = std::min(m, row0 + tile);
+        size_t col0 = b * tile, col1 = std::min(n, col0 + tile), width = col1 - col0;
+        size_t d = a + b;
+        uint32_t diag = (a == 0 || b == 0) ? 0 : corner[d & 1][b];
+        if (b + 1 < tile_cols) corner[(d + 1) & 1][b + 1] = bottom[col1 - 1]; // Before it is overwritten
+
+        prev[0] = diag;
+        std::copy(bottom.begin() + col0, bottom.begin() + col1, prev.begin() + 1);
+        for (size_t i = row0; i < row1; ++i) {
+            uint32_t left_above = right[i]; // dp[i][col0 - 1], left block's value
+            cur[0] = left_above;
+            uint32_t row_max = lcs_row(s2.data() + col0, width, s1[i], prev.data(), cur.data());
+            best.offer(row_max, i + 1);
+            right[i] = cur[width];
+            std::swap(prev, cur);
+            prev[0] = left_above; // Diagonal input for the next row
+        }
+        std::copy(prev.begin() + 1, prev.begin() + 1 + width, bottom.begin() + col0);
+    };
+
+    std::vector<std::vector<uint32_t>> prev_rows(threads, std::vector<uint32_t>(tile + 1)),
+                                       cur_rows(threads, std::vector<uint32_t>(tile + 1));
+    for (size_t d = 0; d < tile_rows + tile_cols - 1; ++d) {
+        size_t a_first = d >= tile_cols ? d - tile_cols + 1 : 0, a_last = std::min(d, tile_rows - 1);
+        std::atomic<size_t> next{a_first};
+        auto worker = [&](unsigned t) {
+            for (size_t a; (a = next.fetch_add(1)) <= a_last;)
+                run_block(a, d - a, prev_rows[t], cur_rows[t], found[t]);
+        };
+        size_t blocks = a_last - a_first + 1;
+        std::vector<std::thread> pool;
+        for (unsigned t = 1; t < std::min<size_t>(threads, blocks); ++t) pool.emplace_back(worker, t);
+        worker(0);
+        for (auto& th : pool) th.join();
+    }
+
+    SubstringMatch best;
+    for (const auto& f : found) best.offer(f.length, f.end);
+    return s1.substr(best.end - best.length, best.length);
+}
+
+struct CommonPattern {
+    std::string text;
+    std::vector<size_t> headlines; // Indices of the headlines containing it
+};
+
+// Generalized suffix automaton over all headlines. Every substring of every
+// headline maps to one state, and each state records how many headlines
+// contain its substrings, so "common to K headlines" is read off directly
+// instead of folding pairwise DP tables (which can also lose the answer once
+// an intermediate result stops being a substring of the true one).
+class HeadlinePatternIndex {
+public:
+    // Owns its copy of the headlines, so a temporary argument is safe
+    explicit HeadlinePatternIndex(std::vector<std::string> texts) : headlines(std::move(texts)) {
+        size_t total = 0;
+        for (const auto& h : headlines) total += h.size();
+        states.reserve(2 * total + 1);
+        edges.reserve(3 * total);
+        states.push_back({0, NONE, NONE, 0, 0, 0, NONE});
+
+        for (uint32_t id = 0; id < headlines.size(); ++id) {
+            uint32_t last = 0;
+            for (uint32_t pos = 0; pos < headlines[id].size(); ++pos)
+                last = extend(last, static_cast<unsigned char>(headlines[id][pos]), id, pos);
+        }
+        // Support counts: each headline marks every state on the suffix-link
+        // paths of its prefixes once; the marker stops repeated climbs early
+        clear_marks();
+        for (uint32_t id = 0; id < headlines.size(); ++id)
+            visit_states(id, [this](uint32_t v) { ++states[v].support; });
+    }
+
+    // Longest substring shared by every headline, in O(states)
+    std::string longest_common() const {
+        uint32_t best = 0;
+        for (uint32_t v = 1; v < states.size(); ++v)
+            if (states[v].support == headlines.size() && states[v].len > states[best].len) best = v;
+        return text_of(best);
+    }
+
+    // The n longest substrings found in at least min_support headlines.
+    // A pattern inside a longer reported one is skipped unless it is
+    // shared more widely.
+    std::vector<CommonPattern> top_common(size_t n, size_t min_support, size_t min_length = 1) const {
+        std::vector<uint32_t> candidates;
+        for (uint32_t v = 1; v < states.size(); ++v)
+            if (states[v].support >= min_support && states[v].len >= min_length) candidates.push_back(v);
+        std::sort(candidates.begin(), candidates.end(), [this](uint32_t a, uint32_t b) {
+            return states[a].len != states[b].len ? states[a].len > states[b].len : states[a].support > states[b].support;
+        });
+
+        std::vector<uint32_t> picked;
+        std::vector<CommonPattern> result;
+        for (uint32_t v : candidates) {
+            if (result.size() == n) break;
+            std::string text = text_of(v);
+            bool redundant = false;
+            for (size_t i = 0; i < result.size() && !redundant; ++i)
+                redundant = states[picked[i]].support == states[v].support &&
+                            result[i].text.find(text) != std::string::npos;
+            if (redundant) continue;
+            picked.push_back(v);
+            result.push_back({std::move(text), {}});
+        }
+
+        // Second marking pass, collecting headline ids for the chosen states
+        std::unordered_map<uint32_t, size_t> slot;
+        for (size_t i = 0; i < picked.size(); ++i) slot.emplace(picked[i], i);
+        clear_marks();
+        for (uint32_t id = 0; id < headlines.size(); ++id) {
+            visit_states(id, [&](uint32_t v) {
+                auto it = slot.find(v);
+                if (it != slot.end()) result[it->second].headlines.push_back(id);
+            });
+        }
+        return result;
+    }
+
+private:
+    static constexpr uint32_t NONE = UINT32_MAX;
+
+    struct State {
+        uint32_t len;          // Longest substring in this state
+        uint32_t link;         // Suffix link
+        uint32_t first_edge;
+        uint32_t end_id, end_pos; // One occurrence: headline and last char
+        uint32_t support;      // Headlines containing this state's substrings
+        mutable uint32_t mark; // Last headline that counted this state
+    };
+    struct Edge {
+        uint32_t target, next; // Next edge of the same state
+        unsigned char c;
+    };
+
+    uint32_t transition(uint32_t v, unsigned char c) const {
+        for (uint32_t e = states[v].first_edge; e != NONE; e = edges[e].next)
+            if (edges[e].c == c) return edges[e].target;
+        return NONE;
+    }
+
+    void redirect(uint32_t v, unsigned char c, uint32_t target) {
+        for (uint32_t e = states[v].first_edge; e != NONE; e = edges[e].next)
+            if (edges[e].c == c) { edges[e].target = target; return; }
+    }
+
+    void add_edge(uint32_t v, unsigned char c, uint32_t target) {
+        edges.push_back({target, states[v].first_edge, c});
+        states[v].first_edge = static_cast<uint32_t>(edges.size() - 1);
+    }
+
+    uint32_t clone(uint32_t q, uint32_t len) {
+        uint32_t copy = static_cast<uint32_t>(states.size());
+        states.push_back({len, states[q].link, NONE, states[q].end_id, states[q].end_pos, 0, NONE});
+        for (uint32_t e = states[q].first_edge; e != NONE; e = edges[e].next) add_edge(copy, edges[e].c, edges[e].target);
+        states[q].link = copy;
+        return copy;
+    }
+
+    // Online extension that reuses existing states when a later headline
+    // repeats a known substring, so no unreachable duplicates are created
+    uint32_t extend(uint32_t last, unsigned char c, uint32_t id, uint32_t pos) {
+        uint32_t q = transition(last, c);
+        if (q != NONE) {
+            if (states[last].len + 1 == states[q].len) return q;
+            uint32_t copy = clone(q, states[last].len + 1);
+            for (uint32_t p = last; p != NONE && transition(p, c) == q; p = states[p].link) redirect(p, c, copy);
+            return copy;
+        }
+
+        uint32_t cur = static_cast<uint32_t>(states.size());
+        states.push_back({states[last].len + 1, 0, NONE, id, pos, 0, NONE});
+        uint32_t p = last;
+        for (; p != NONE && (q = transition(p, c)) == NONE; p = states[p].link) add_edge(p, c, cur);
+        if (p == NONE) return cur;
+        if (states[p].len + 1 == states[q].len) {
+            states[cur].link = q;
+        } else {
+            uint32_t copy = clone(q, states[p].len + 1);
+            for (; p != NONE && transition(p, c) == q; p = states[p].link) redirect(p, c, copy);
+            states[cur].link = copy;
+        }
+        return cur;
+    }
+
+    // Calls visit once for every state whose substrings occur in headline id
+    template <typename Visit>
+    void visit_states(uint32_t id, Visit visit) const {
+        uint32_t v = 0;
+        for (char ch : headlines[id]) {
+            v = transition(v, static_cast<unsigned char>(ch));
+            for (uint32_t u = v; u != 0 && states[u].mark != id; u = states[u].link) {
+                states[u].mark = id;
+                visit(u);
+            }
+        }
+    }
+
+    void clear_marks() const {
+        for (const State& s : states) s.mark = NONE;
+    }
+
+    std::string text_of(uint32_t v) const {
+        if (v == 0) return "";
+        const State& s = states[v];
+        return headlines[s.end_id].substr(s.end_pos + 1 - s.len, s.len);
+    }
+
+    std::vector<std::string> headlines;
+    std::vector<State> states;
+    std::vector<Edge> edges;
+};
+
 std::string analyze_headline_patterns(const std::vector<std::string>& top_headlines) {
     if (top_headlines.empty()) return "";
-    
-    std::string common = top_headlines[0];
-    for (size_t i = 1; i < top_headlines.size(); ++i) {
-        common = longest_common_substring(common, top_headlines[i]);
-        if (common.empty()) break;
-    }
-    
-    return common;
+    return HeadlinePatternIndex(top_headlines).longest_common();
 }
 
 int main() {
@@ -49,6 +351,44 @@ int main() {
     std::string common_pattern = analyze_headline_patterns(headlines);
     std::cout << "Common successful pattern in headlines: \"" 
               << common_pattern << "\"\n";
-    
+
+    // Patterns shared by at least two of the headlines, longest first
+    HeadlinePatternIndex index(headlines);
+    for (const auto& pattern : index.top_common(3, 2, 4)) {
+        std::cout << "\"" << pattern.text << "\" appears in headlines";
+        for (size_t id : pattern.headlines) std::cout << " " << id;
+        std::cout << "\n";
+    }
+
+    // Article bodies: the quadratic table needs (m+1)(n+1) ints, ~40 GB at 100k
+    std::cout << "\nLongest common substring of two article bodies:\n";
+    std::mt19937 rng(11);
+    auto random_text = [&](size_t length) {
+        std::string text(length, ' ');
+        for (char& ch : text) ch = "etaoinshrdlu "[rng() % 13];
+        return text;
+    };
+    auto time_it = [](auto&& run) {
+        auto start = std::chrono::steady_clock::now();
+        std::string found = run();
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        return std::make_pair(found.size(), ms);
+    };
+    for (size_t length : {1000, 10000, 100000}) {
+        std::string a = random_text(length), b = random_text(length);
+        std::string shared = random_text(40); // Plant a shared passage
+        a.replace(length / 3, shared.size(), shared);
+        b.replace(length / 2, shared.size(), shared);
+
+        std::cout << "  " << length << " chars:";
+        if (length <= 10000) {
+            auto [len, ms] = time_it([&] { return longest_common_substring(a, b); });
+            std::cout << "  table " << ms << " ms (" << len << ")";
+        }
+        auto [len2, ms2] = time_it([&] { return longest_common_substring_linear(a, b); });
+        auto [len3, ms3] = time_it([&] { return longest_common_substring_parallel(a, b); });
+        std::cout << "  two-row " << ms2 << " ms (" << len2 << ")  wavefront " << ms3 << " ms (" << len3 << ")\n";
+    }
+
     return 0;
-}
\ No newline at end of file
+}
@@ -1,50 +1,427 @@
 #include <iostream>
 #include <unordered_map>
 #include <string>
+#include <vector>
+#include <set>
+#include <cmath>
+#include <limits>
+#include <optional>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <chrono>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
 
 // Problem: Slow access to real-time performance metrics hinders live decisions
-// Solution: Look-up tables provide instant O(1) access to content metrics
+// Solution: Columnar look-up table: content IDs map to dense rows, each
+// attribute is a contiguous double column, and per-column ranking indexes are
+// kept up to date on write so best-performing queries never scan. Every
+// update is also appended to a compressed history for trend queries
 
-class ContentMetrics {
+// Aggregate over a time window of one metric's history
+struct WindowStats {
+    size_t count = 0;
+    double min = std::numeric_limits<double>::infinity();
+    double max = -std::numeric_limits<double>::infinity();
+    double sum = 0;
+
+    double avg() const { return count ? sum / count : std::numeric_limits<double>::quiet_NaN(); }
+
+    void add(double v) {
+        ++count;
+        min = std::min(min, v);
+        max = std::max(max, v);
+        sum += v;
+    }
+
+    void merge(const WindowStats& other) {
+        count += other.count;
+        min = std::min(min, other.min);
+        max = std::max(max, other.max);
+        sum += other.sum;
+    }
+};
+
+// Append-only history of one (content, attribute) metric, Gorilla-compressed:
+// timestamps as delta-of-delta, values XORed with their predecessor, packed
+// into fixed-size blocks that each start from raw values and carry a summary.
+// Window aggregates read the summaries of fully covered blocks and decode only
+// the (at most two) blocks at the window edges. Block payloads grow on demand,
+// so short and sparse series cost little more than their raw points.
+class MetricSeries {
 public:
-    void update_metric(const std::string& content_id, const std::string& attribute, double value) {
-        // Real-time update of metrics
-        metrics[content_id][attribute] = value;
-    }
-    
-    double get_metric(const std::string& content_id, const std::string& attribute) {
-        // Instant lookup for decision-making
-        return metrics[content_id][attribute];
-    }
-    
-    std::string get_best_performing(const std::string& attribute) {
-        // Find best performing content for an attribute
-        std::string best_id;
-        double max_val = -1;
-        for (const auto& [id, attrs] : metrics) {
-            if (attrs.count(attribute) && attrs.at(attribute) > max_val) {
-                max_val = attrs.at(attribute);
-                best_id = id;
+    // A point older than the newest one (e.g., the wall clock stepped back)
+    // is kept at the newest timestamp so history stays ordered
+    void append(int64_t timestamp, double value) {
+        if (!blocks.empty()) timestamp = std::max(timestamp, blocks.back().summary_last);
+        if (blocks.empty() || !blocks.back().fits_record()) {
+            blocks.emplace_back();
+            blocks.back().start(timestamp, value, encoder);
+            return;
+        }
+        blocks.back().append(timestamp, value, encoder);
+    }
+
+    // min/max/avg over [from, to] without decompressing interior blocks
+    WindowStats aggregate(int64_t from, int64_t to) const {
+        WindowStats stats;
+        auto first = std::lower_bound(blocks.begin(), blocks.end(), from,
+            [](const Block& b, int64_t t) { return b.summary_last < t; });
+        for (auto it = first; it != blocks.end() && it->summary_first <= to; ++it) {
+            if (it->summary_first >= from && it->summary_last <= to) {
+                stats.merge(it->summary);
+            } else {
+                it->decode([&](int64_t t, double v) {
+                    if (t >= from && t <= to) stats.add(v);
+                });
+            }
+        }
+        return stats;
+    }
+
+    size_t points() const {
+        size_t n = 0;
+        for (const auto& b : blocks) n += b.summary.count;
+        return n;
+    }
+
+    size_t bytes() const {
+        size_t total = sizeof(*this) + blocks.capacity() * sizeof(Block);
+        for (const auto& b : blocks) total += b.words.capacity() * sizeof(uint64_t);
+        return total;
+    }
+
+private:
+    static constexpr size_t BLOCK_WORDS = 32; // At most 256 bytes of payload per block
+    static constexpr size_t BLOCK_BITS = BLOCK_WORDS * 64;
+    static constexpr size_t MAX_RECORD_BITS = (4 + 64) + (2 + 5 + 6 + 64);
+
+    // State for the next append; only the last block is ever appended to
+    struct Encoder {
+        int64_t prev_time = 0, prev_delta = 0;
+        uint64_t prev_bits = 0;
+        int prev_leading = -1, prev_trailing = 0;
+    };
+
+    struct Block {
+        std::vector<uint64_t> words; // Doubles as records arrive, up to BLOCK_WORDS
+        uint32_t bit_count = 0;
+        WindowStats summary;
+        int64_t summary_first = 0, summary_last = 0;
+
+        bool fits_record() const { return bit_count + MAX_RECORD_BITS <= BLOCK_BITS; }
+
+        void reserve_record() {
+            size_t needed = (bit_count + MAX_RECORD_BITS + 63) / 64;
+            if (words.size() < needed)
+                words.resize(std::min(BLOCK_WORDS, std::max(needed, 2 * words.size())));
+        }
+
+        void write(uint64_t value, int bits) {
+            if (bits == 0) return;
+            if (bits < 64) value &= (uint64_t(1) << bits) - 1;
+            size_t word = bit_count >> 6, offset = bit_count & 63;
+            words[word] |= value << offset;
+            if (offset + bits > 64) words[word + 1] |= value >> (64 - offset);
+            bit_count += bits;
+        }
+
+        void start(int64_t timestamp, double value, Encoder& enc) {
+            uint64_t bits;
+            std::memcpy(&bits, &value, sizeof bits);
+            words.resize(2); // Exactly the raw first point
+            write(static_cast<uint64_t>(timestamp), 64);
+            write(bits, 64);
+            summary_first = summary_last = timestamp;
+            enc = Encoder();
+            enc.prev_time = timestamp;
+            enc.prev_bits = bits;
+            summary.add(value);
+        }
+
+        void append(int64_t timestamp, double value, Encoder& enc) {
+            reserve_record();
+            // Timestamps: regular intervals collapse to a single 0 bit
+            int64_t delta = timestamp - enc.prev_time;
+            int64_t dod = delta - enc.prev_delta;
+            if (dod == 0) {
+                write(0b0, 1);
+            } else if (dod >= -64 && dod <= 63) {
+                write(0b01, 2);
+                write(static_cast<uint64_t>(dod), 7);
+            } else if (dod >= -256 && dod <= 255) {
+                write(0b011, 3);
+                write(static_cast<uint64_t>(dod), 9);
+            } else if (dod >= -2048 && dod <= 2047) {
+                write(0b0111, 4);
+                write(static_cast<uint64_t>(dod), 12);
+            } else {
+                write(0b1111, 4);
+                write(static_cast<uint64_t>(dod), 64);
+            }
+
+            // Values: XOR with the previous value, storing only meaningful bits
+            uint64_t bits;
+            std::memcpy(&bits, &value, sizeof bits);
+            uint64_t x = bits ^ enc.prev_bits;
+            if (x == 0) {
+                write(0b0, 1);
+            } else {
+                int leading = std::min(__builtin_clzll(x), 31);
+                int trailing = __builtin_ctzll(x);
+                if (enc.prev_leading >= 0 && leading >= enc.prev_leading && trailing >= enc.prev_trailing) {
+                    write(0b01, 2); // Fits the previous window
+                    write(x >> enc.prev_trailing, 64 - enc.prev_leading - enc.prev_trailing);
+                } else {
+                    int meaningful = 64 - leading - trailing;
+                    write(0b11, 2);
+                    write(static_cast<uint64_t>(leading), 5);
+                    write(static_cast<uint64_t>(meaningful & 63), 6); // 64 stored as 0
+                    write(x >> trailing, meaningful);
+                    enc.prev_leading = leading;
+                    enc.prev_trailing = trailing;
+                }
+            }
+
+            enc.prev_delta = delta;
+            enc.prev_time = timestamp;
+            enc.prev_bits = bits;
+            summary_last = timestamp;
+            summary.add(value);
+        }
+
+        template <typename Visit>
+        void decode(Visit visit) const {
+            size_t pos = 0;
+            auto read = [&](int bits) -> uint64_t {
+                if (bits == 0) return 0;
+                size_t word = pos >> 6, offset = pos & 63;
+                uint64_t value = words[word] >> offset;
+                if (offset + bits > 64) value |= words[word + 1] << (64 - offset);
+                pos += bits;
+                return bits < 64 ? value & ((uint64_t(1) << bits) - 1) : value;
+            };
+            auto sign_extend = [](uint64_t v, int bits) {
+                return static_cast<int64_t>(v << (64 - bits)) >> (64 - bits);
+            };
+
+            int64_t time = static_cast<int64_t>(read(64));
+            uint64_t bits = read(64);
+            int64_t delta = 0;
+            int leading = 0, trailing = 0;
+            for (size_t i = 0; i < summary.count; ++i) {
+                if (i > 0) {
+                    int64_t dod;
+                    if (!read(1)) dod = 0;
+                    else if (!read(1)) dod = sign_extend(read(7), 7);
+                    else if (!read(1)) dod = sign_extend(read(9), 9);
+                    else if (!read(1)) dod = sign_extend(read(12), 12);
+                    else dod = static_cast<int64_t>(read(64));
+                    delta += dod;
+                    time += delta;
+
+                    if (read(1)) {
+                        if (read(1)) {
+                            leading = static_cast<int>(read(5));
+                            int meaningful = static_cast<int>(read(6));
+                            if (meaningful == 0) meaningful = 64;
+                            trailing = 64 - leading - meaningful;
+                        }
+                        bits ^= read(64 - leading - trailing) << trailing;
+                    }
+                }
+                double value;
+                std::memcpy(&value, &bits, sizeof value);
+                visit(time, value);
             }
         }
-        return best_id;
+    };
+
+    std::vector<Block> blocks;
+    Encoder encoder;
+};
+
+class ContentMetrics {
+public:
+    using Column = uint32_t;
+
+    // Interns an attribute once; hot paths can keep the returned handle
+    Column column(const std::string& attribute) {
+        auto [it, inserted] = column_ids.emplace(attribute, static_cast<Column>(columns.size()));
+        if (inserted) columns.emplace_back();
+        return it->second;
+    }
+
+    void update_metric(const std::string& content_id, const std::string& attribute, double value,
+                       int64_t timestamp_ms = now_ms()) {
+        update_metric(content_id, column(attribute), value, timestamp_ms);
+    }
+
+    // Real-time update of metrics: O(1) write plus O(logN) ranking upkeep,
+    // and the value joins the cell's history (late timestamps are clamped)
+    void update_metric(const std::string& content_id, Column col, double value,
+                       int64_t timestamp_ms = now_ms()) {
+        uint32_t row = row_for(content_id);
+        ColumnData& data = columns[col];
+        if (data.values.size() <= row) data.values.resize(row_ids.size(), MISSING);
+        if (data.history.size() <= row) data.history.resize(row_ids.size());
+        if (!std::isnan(value)) data.history[row].append(timestamp_ms, value);
+
+        double& cell = data.values[row];
+        if (!std::isnan(cell)) data.ranking.erase({cell, row});
+        cell = value;
+        if (!std::isnan(value)) data.ranking.insert({value, row}); // NaN clears the cell
+    }
+
+    // Instant lookup for decision-making; a miss inserts nothing
+    std::optional<double> get_metric(const std::string& content_id, const std::string& attribute) const {
+        auto row = row_index.find(content_id);
+        auto col = column_ids.find(attribute);
+        if (row == row_index.end() || col == column_ids.end()) return std::nullopt;
+        const auto& values = columns[col->second].values;
+        if (row->second >= values.size() || std::isnan(values[row->second])) return std::nullopt;
+        return values[row->second];
+    }
+
+    // O(1): the column's ranking index already holds the maximum
+    std::string get_best_performing(const std::string& attribute) const {
+        auto col = column_ids.find(attribute);
+        if (col == column_ids.end() || columns[col->second].ranking.empty()) return "";
+        return row_ids[columns[col->second].ranking.rbegin()->second];
+    }
+
+    // Best k content IDs for an attribute in O(k), straight off the index
+    std::vector<std::string> get_top_k(const std::string& attribute, size_t k) const {
+        std::vector<std::string> result;
+        auto col = column_ids.find(attribute);
+        if (col == column_ids.end()) return result;
+        const auto& ranking = columns[col->second].ranking;
+        for (auto it = ranking.rbegin(); it != ranking.rend() && result.size() < k; ++it)
+            result.push_back(row_ids[it->second]);
+        return result;
+    }
+
+    // Trend over [from_ms, to_ms] from the compressed history
+    WindowStats get_trend(const std::string& content_id, const std::string& attribute,
+                          int64_t from_ms, int64_t to_ms) const {
+        auto row = row_index.find(content_id);
+        auto col = column_ids.find(attribute);
+        if (row == row_index.end() || col == column_ids.end()) return {};
+        const auto& history = columns[col->second].history;
+        if (row->second >= history.size()) return {};
+        return history[row->second].aggregate(from_ms, to_ms);
+    }
+
+    // Ad-hoc scan: mean over content that has this attribute
+    double column_mean(const std::string& attribute) const {
+        auto col = column_ids.find(attribute);
+        if (col == column_ids.end()) return MISSING;
+        const auto& values = columns[col->second].values;
+        double sum = 0;
+        size_t present = 0;
+        size_t i = 0;
+#ifdef __AVX2__
+        __m256d sums = _mm256_setzero_pd();
+        for (; i + 4 <= values.size(); i += 4) {
+            __m256d v = _mm256_loadu_pd(values.data() + i);
+            __m256d ordered = _mm256_cmp_pd(v, v, _CMP_ORD_Q); // False for missing (NaN)
+            sums = _mm256_add_pd(sums, _mm256_and_pd(v, ordered));
+            present += __builtin_popcount(_mm256_movemask_pd(ordered));
+        }
+        alignas(32) double lanes[4];
+        _mm256_store_pd(lanes, sums);
+        sum = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+#endif
+        for (; i < values.size(); ++i) {
+            if (std::isnan(values[i])) continue;
+            sum += values[i];
+            ++present;
+        }
+        return present ? sum / present : MISSING;
+    }
+
+    // Ad-hoc scan: how much content beats a threshold on this attribute
+    size_t count_above(const std::string& attribute, double threshold) const {
+        auto col = column_ids.find(attribute);
+        if (col == column_ids.end()) return 0;
+        const auto& values = columns[col->second].values;
+        size_t count = 0;
+        size_t i = 0;
+#ifdef __AVX2__
+        __m256d limit = _mm256_set1_pd(threshold);
+        for (; i + 4 <= values.size(); i += 4) {
+            __m256d above = _mm256_cmp_pd(_mm256_loadu_pd(values.data() + i), limit, _CMP_GT_OQ);
+            count += __builtin_popcount(_mm256_movemask_pd(above));
+        }
+#endif
+        for (; i < values.size(); ++i)
+            count += values[i] > threshold; // NaN compares false
+        return count;
     }
 
 private:
-    std::unordered_map<std::string, std::unordered_map<std::string, double>> metrics;
+    static constexpr double MISSING = std::numeric_limits<double>::quiet_NaN();
+
+    static int64_t now_ms() {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+
+    struct ColumnData {
+        std::vector<double> values;                    // Indexed by row, NaN if unset
+        std::set<std::pair<double, uint32_t>> ranking; // (value, row) for set cells
+        std::vector<MetricSeries> history;             // Indexed by row
+    };
+
+    uint32_t row_for(const std::string& content_id) {
+        auto [it, inserted] = row_index.emplace(content_id, static_cast<uint32_t>(row_ids.size()));
+        if (inserted) row_ids.push_back(content_id);
+        return it->second;
+    }
+
+    std::unordered_map<std::string, uint32_t> row_index; // Content ID -> row
+    std::vector<std::string> row_ids;                    // Row -> content ID
+    std::unordered_map<std::string, Column> column_ids;  // Attribute -> column
+    std::vector<ColumnData> columns;
 };
 
 int main() {
     ContentMetrics analytics;
-    
+
     // Simulate real-time updates
     analytics.update_metric("article123", "click_rate", 0.15);
     analytics.update_metric("article123", "read_time", 45.2);
     analytics.update_metric("article456", "click_rate", 0.22);
-    
+
+    // Hot ingest paths keep the interned column handle
+    auto click_rate = analytics.column("click_rate");
+    analytics.update_metric("article789", click_rate, 0.31);
+    analytics.update_metric("article789", click_rate, 0.12); // Engagement dropped
+
     // Instant access for real-time decisions
-    std::cout << "Best performing article for clicks: " 
+    std::cout << "Best performing article for clicks: "
               << analytics.get_best_performing("click_rate") << "\n";
-    
+    std::cout << "Average click rate: " << analytics.column_mean("click_rate") << "\n";
+    std::cout << "Articles above 0.14 click rate: " << analytics.count_above("click_rate", 0.14) << "\n";
+    // A minute of per-second click-rate samples, then the trend over 30s
+    int64_t t0 = 1700000000000;
+    for (int s = 0; s < 60; ++s)
+        analytics.update_metric("article999", click_rate, 0.10 + 0.002 * s, t0 + 1000 * s);
+    WindowStats trend = analytics.get_trend("article999", "click_rate", t0 + 30000, t0 + 59000);
+    std::cout << "article999 click rate, last 30s: min " << trend.min << ", max " << trend.max
+              << ", avg " << trend.avg() << "\n";
+
+    // History cost per point, for a busy series and a barely used one
+    MetricSeries busy, sparse;
+    for (int s = 0; s < 3600; ++s) busy.append(t0 + 1000 * s, 0.10 + 0.0001 * (s % 50));
+    sparse.append(t0, 0.42);
+    std::cout << "History bytes/point: busy " << busy.bytes() / double(busy.points())
+              << ", single point " << sparse.bytes() << "\n";
+
+    if (!analytics.get_metric("article456", "read_time"))
+        std::cout << "article456 has no read_time yet\n";
+
     return 0;
-}
\ No newline at end of file
+}
@@ -2,52 +2,507 @@
 #include <vector>
 #include <random>
 #include <algorithm>
+#include <numeric>
+#include <functional>
+#include <unordered_map>
+#include <cmath>
+#include <cstdint>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <stdexcept>
 
 // Problem: Traditional A/B testing requires large user pools, causing delays
 // Solution: Statistical sampling allows reliable decisions with smaller, representative samples
 
+// xoshiro256**: a few cycles per draw, one instance per thread, no syscalls
+class Xoshiro256 {
+public:
+    explicit Xoshiro256(uint64_t seed) {
+        for (auto& word : s) { // splitmix64 expands the seed
+            seed += 0x9E3779B97F4A7C15ULL;
+            uint64_t z = seed;
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            word = z ^ (z >> 31);
+        }
+    }
+
+    uint64_t next() {
+        uint64_t result = rotl(s[1] * 5, 7) * 9;
+        uint64_t t = s[1] << 17;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 45);
+        return result;
+    }
+
+    // Uniform in the open interval (0, 1), safe to take the log of
+    double uniform() { return ((next() >> 11) + 0.5) * 0x1.0p-53; }
+
+    // Uniform in [0, n) without modulo bias (Lemire)
+    uint64_t below(uint64_t n) {
+        __uint128_t m = static_cast<__uint128_t>(next()) * n;
+        if (static_cast<uint64_t>(m) < n) {
+            uint64_t threshold = -n % n;
+            while (static_cast<uint64_t>(m) < threshold) m = static_cast<__uint128_t>(next()) * n;
+        }
+        return static_cast<uint64_t>(m >> 64);
+    }
+
+private:
+    static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+    uint64_t s[4];
+};
+
+// Seeded once per thread from the OS, then never touches it again
+inline Xoshiro256& thread_rng() {
+    thread_local Xoshiro256 rng(std::random_device{}() * 0x100000001ULL ^ std::random_device{}());
+    return rng;
+}
+
+// Uniform reservoir over an unbounded stream (Algorithm L): after the
+// reservoir fills, it jumps straight to the next accepted item, so the
+// per-item cost is a compare and the RNG runs O(k log(N/k)) times in total
+class Reservoir {
+public:
+    explicit Reservoir(size_t capacity) : capacity(capacity) {
+        if (capacity == 0) throw std::invalid_argument("Reservoir capacity must be positive");
+        items.reserve(capacity);
+    }
+
+    void observe(int value, Xoshiro256& rng) {
+        if (seen < capacity) {
+            items.push_back(value);
+            if (++seen == capacity) {
+                w = std::exp(std::log(rng.uniform()) / capacity);
+                next_pick = capacity - 1;
+                schedule_next(rng);
+            }
+            return;
+        }
+        if (seen++ == next_pick) {
+            items[rng.below(capacity)] = value;
+            w *= std::exp(std::log(rng.uniform()) / capacity);
+            schedule_next(rng);
+        }
+    }
+
+    // Moves a uniform random subset of `count` items to the front and
+    // returns it: a partial Fisher-Yates, O(count). Reordering the
+    // reservoir keeps it a uniform sample of the stream.
+    const int* draw(size_t count, Xoshiro256& rng) {
+        for (size_t i = 0; i < count; ++i)
+            std::swap(items[i], items[i + rng.below(items.size() - i)]);
+        return items.data();
+    }
+
+    size_t size() const { return items.size(); }
+    uint64_t stream_size() const { return seen; }
+
+private:
+    void schedule_next(Xoshiro256& rng) {
+        next_pick += static_cast<uint64_t>(std::floor(std::log(rng.uniform()) / std::log1p(-w))) + 1;
+    }
+
+    size_t capacity;
+    std::vector<int> items;
+    uint64_t seen = 0;
+    uint64_t next_pick = 0; // Stream index of the next item to accept
+    double w = 0;
+};
+
+// Welford running mean/variance: O(1) per observation, numerically stable,
+// and mergeable (Chan et al.) so per-thread partials combine exactly
+struct RunningStats {
+    uint64_t count = 0;
+    double mean = 0, m2 = 0;
+
+    void add(double x) {
+        ++count;
+        double delta = x - mean;
+        mean += delta / count;
+        m2 += delta * (x - mean);
+    }
+
+    void merge(const RunningStats& other) {
+        if (other.count == 0) return;
+        uint64_t total = count + other.count;
+        double delta = other.mean - mean;
+        mean += delta * other.count / total;
+        m2 += other.m2 + delta * delta * (static_cast<double>(count) * other.count / total);
+        count = total;
+    }
+
+    double variance() const { return count > 1 ? m2 / (count - 1) : 0.0; }
+};
+
+struct SequentialResult {
+    enum class Verdict { Continue, VariantA, VariantB };
+    Verdict verdict = Verdict::Continue;
+    double lift = 0;            // mean(B) - mean(A)
+    double low = -INFINITY;     // Always-valid confidence sequence on the lift
+    double high = INFINITY;
+    double p_value = 1;         // Always-valid p-value at this look
+    uint64_t samples = 0;
+};
+
+// Mixture sequential probability ratio test (mSPRT) on the difference of
+// means, with a normal N(0, mixture_sd^2) mixture over the effect. Peeking
+// after every observation keeps the false-positive rate below alpha, unlike
+// repeatedly applying a fixed-horizon test.
+class MixtureSPRT {
+public:
+    // mixture_sd: typical effect size in metric units; min_samples per arm
+    // before the plug-in variances are trusted
+    MixtureSPRT(double alpha, double mixture_sd, uint64_t min_samples = 100)
+        : alpha(alpha), tau2(mixture_sd * mixture_sd), min_samples(min_samples) {}
+
+    SequentialResult evaluate(const RunningStats& a, const RunningStats& b) const {
+        SequentialResult result;
+        result.samples = a.count + b.count;
+        result.lift = b.mean - a.mean;
+        if (a.count < min_samples || b.count < min_samples) return result;
+
+        double v = a.variance() / a.count + b.variance() / b.count; // Var of the lift
+        if (v <= 0) return result;
+        double log_lambda = 0.5 * std::log(v / (v + tau2)) +
+                            tau2 * result.lift * result.lift / (2 * v * (v + tau2));
+        double radius = std::sqrt(v * (v + tau2) / tau2 * (2 * std::log(1 / alpha) + std::log((v + tau2) / v)));
+        result.low = result.lift - radius;
+        result.high = result.lift + radius;
+        result.p_value = std::min(1.0, std::exp(-log_lambda));
+        if (result.p_value <= alpha)
+            result.verdict = result.lift > 0 ? SequentialResult::Verdict::VariantB : SequentialResult::Verdict::VariantA;
+        return result;
+    }
+
+private:
+    double alpha, tau2;
+    uint64_t min_samples;
+};
+
 class ABSampler {
 public:
-    ABSampler(const std::vector<int>& population) : population(population) {}
-    
-    // Stratified sampling to ensure representative subsets
-    std::vector<int> get_sample(int sample_size) {
-        std::vector<int> sample;
-        std::sample(population.begin(), population.end(), std::back_inserter(sample),
-                   sample_size, std::mt19937{std::random_device{}()});
+    // A sampled user and how many users of the stream it stands for
+    struct WeightedValue {
+        int value;
+        double weight; // Stratum stream size / draws from that stratum
+    };
+
+    enum class Allocation {
+        Proportional, // n_h ∝ N_h
+        Neyman        // n_h ∝ N_h * S_h: more draws where engagement varies more
+    };
+
+    // Each stratum (device, region, cohort...) keeps its own reservoir
+    explicit ABSampler(size_t reservoir_size = 1000, Allocation allocation = Allocation::Proportional)
+        : reservoir_size(reservoir_size), allocation(allocation) {}
+
+    // One user from the live stream; O(1), single writer
+    void observe(int stratum_key, int value) {
+        auto [it, inserted] = index.emplace(stratum_key, static_cast<uint32_t>(strata.size()));
+        if (inserted) strata.push_back(Stratum{Reservoir(reservoir_size), {}});
+        Stratum& stratum = strata[it->second];
+        stratum.reservoir.observe(value, thread_rng());
+        stratum.stats.add(value); // Running variance feeds the Neyman weights
+    }
+
+    // Stratified sample: sizes are allocated across strata, then drawn from
+    // each reservoir. O(sample_size + strata), independent of the population.
+    // Neyman allocation oversamples high-variance strata, so every value
+    // carries its stratum's weight; estimates must use it.
+    std::vector<WeightedValue> get_sample(int sample_size) {
+        std::vector<WeightedValue> sample;
+        std::vector<size_t> counts = allocate(static_cast<size_t>(std::max(sample_size, 0)));
+        sample.reserve(std::accumulate(counts.begin(), counts.end(), size_t{0}));
+        for (size_t h = 0; h < strata.size(); ++h) {
+            if (counts[h] == 0) continue;
+            const int* drawn = strata[h].reservoir.draw(counts[h], thread_rng());
+            double weight = static_cast<double>(strata[h].reservoir.stream_size()) / counts[h];
+            for (size_t i = 0; i < counts[h]; ++i) sample.push_back({drawn[i], weight});
+        }
         return sample;
     }
-    
-    // Early termination if variant shows significant difference
-    bool should_terminate_early(const std::vector<int>& variantA, 
-                               const std::vector<int>& variantB, 
-                               double threshold) {
-        double meanA = calculate_mean(variantA);
-        double meanB = calculate_mean(variantB);
-        return std::abs(meanA - meanB) > threshold;
+
+    // Early termination only when a sequential test says the variants
+    // differ; safe to ask again after every new batch of users
+    bool should_terminate_early(const std::vector<WeightedValue>& variantA,
+                               const std::vector<WeightedValue>& variantB,
+                               const MixtureSPRT& test) {
+        return test.evaluate(weighted_stats(variantA), weighted_stats(variantB)).verdict !=
+               SequentialResult::Verdict::Continue;
     }
 
 private:
-    double calculate_mean(const std::vector<int>& data) {
-        return std::accumulate(data.begin(), data.end(), 0.0) / data.size();
+    struct Stratum {
+        Reservoir reservoir;
+        RunningStats stats; // Over the whole stream, not just the reservoir
+    };
+
+    // Weighted mean and variance, with the count replaced by Kish's effective
+    // sample size (sum w)^2 / sum w^2, so unequal weights widen the test
+    static RunningStats weighted_stats(const std::vector<WeightedValue>& sample) {
+        double total = 0, total_sq = 0, sum = 0;
+        for (const auto& [value, weight] : sample) {
+            total += weight;
+            total_sq += weight * weight;
+            sum += weight * value;
+        }
+        RunningStats stats;
+        if (total <= 0) return stats;
+        stats.mean = sum / total;
+        double spread = 0;
+        for (const auto& [value, weight] : sample) spread += weight * (value - stats.mean) * (value - stats.mean);
+        stats.count = static_cast<uint64_t>(std::llround(total * total / total_sq));
+        if (stats.count > 1) stats.m2 = spread / total * stats.count;
+        return stats;
     }
-    
-    std::vector<int> population;
+
+    // Largest-remainder rounding of the allocation weights; strata whose
+    // reservoirs run short hand their surplus to the others
+    std::vector<size_t> allocate(size_t sample_size) const {
+        std::vector<double> weight(strata.size());
+        for (size_t h = 0; h < strata.size(); ++h) {
+            double n_h = static_cast<double>(strata[h].reservoir.stream_size());
+            weight[h] = n_h;
+            if (allocation == Allocation::Neyman && n_h > 1)
+                weight[h] = n_h * std::sqrt(strata[h].stats.variance());
+        }
+        double total = std::accumulate(weight.begin(), weight.end(), 0.0);
+        if (total <= 0) { // No spread anywhere yet: fall back to stream sizes
+            for (size_t h = 0; h < strata.size(); ++h)
+                weight[h] = static_cast<double>(strata[h].reservoir.stream_size());
+            total = std::accumulate(weight.begin(), weight.end(), 0.0);
+        }
+
+        std::vector<size_t> counts(strata.size(), 0);
+        if (total <= 0) return counts;
+        size_t assigned = 0;
+        std::vector<std::pair<double, size_t>> remainders;
+        for (size_t h = 0; h < strata.size(); ++h) {
+            double exact = sample_size * weight[h] / total;
+            counts[h] = std::min(static_cast<size_t>(exact), strata[h].reservoir.size());
+            assigned += counts[h];
+            remainders.push_back({exact - std::floor(exact), h});
+        }
+        std::sort(remainders.begin(), remainders.end(), std::greater<>());
+
+        // Hand out what rounding and short reservoirs left over, largest
+        // remainder first, cycling while any stratum still has items
+        while (assigned < sample_size) {
+            bool progressed = false;
+            for (const auto& [remainder, h] : remainders) {
+                if (assigned == sample_size) break;
+                if (counts[h] < strata[h].reservoir.size()) {
+                    ++counts[h];
+                    ++assigned;
+                    progressed = true;
+                }
+            }
+            if (!progressed) break; // Every reservoir is exhausted
+        }
+        return counts;
+    }
+
+    size_t reservoir_size;
+    Allocation allocation;
+    std::vector<Stratum> strata;
+    std::unordered_map<int, uint32_t> index; // Stratum key -> strata slot
+};
+
+// Thousands of live experiments fed by many ingest threads. Every arm keeps
+// MAX_WRITERS Welford slots behind seqlocks. A writer claims any idle slot by
+// flipping its sequence odd, so concurrent writers land on different slots,
+// and evaluation merges consistent slot snapshots.
+class ExperimentEngine {
+public:
+    static constexpr size_t MAX_WRITERS = 16; // Slots per arm; more writers share them
+
+    ExperimentEngine(size_t experiment_count, MixtureSPRT test)
+        : experiments(std::make_unique<Experiment[]>(experiment_count)), experiment_count(experiment_count), test(test) {}
+
+    // O(1) on an idle slot of the arm. arm is 0 (A) or 1 (B). Each thread
+    // starts from the slot it used last, which is normally still idle.
+    void record(size_t experiment, int arm, double value) {
+        thread_local size_t hint = std::hash<std::thread::id>{}(std::this_thread::get_id()) % MAX_WRITERS;
+        Slot* slots = experiments[experiment].arms[arm];
+        size_t index = hint;
+        uint32_t seq;
+        for (size_t tries = 1;; ++tries, index = (index + 1) % MAX_WRITERS) {
+            seq = slots[index].sequence.load(std::memory_order_relaxed);
+            // Odd: updating. Acquire pairs with the previous writer's release.
+            if (!(seq & 1) && slots[index].sequence.compare_exchange_weak(
+                                  seq, seq + 1, std::memory_order_acquire, std::memory_order_relaxed))
+                break;
+            if (tries % MAX_WRITERS == 0) std::this_thread::yield(); // Every slot busy
+        }
+        hint = index;
+        Slot& slot = slots[index];
+        std::atomic_thread_fence(std::memory_order_release);
+
+        uint64_t n = slot.count.load(std::memory_order_relaxed) + 1;
+        double mean = slot.mean.load(std::memory_order_relaxed);
+        double delta = value - mean;
+        mean += delta / n;
+        slot.count.store(n, std::memory_order_relaxed);
+        slot.mean.store(mean, std::memory_order_relaxed);
+        slot.m2.store(slot.m2.load(std::memory_order_relaxed) + delta * (value - mean), std::memory_order_relaxed);
+
+        slot.sequence.store(seq + 2, std::memory_order_release);
+    }
+
+    // Safe from any thread. A decision, once reached, is final.
+    SequentialResult evaluate(size_t experiment) {
+        Experiment& e = experiments[experiment];
+        SequentialResult result = test.evaluate(arm_stats(e, 0), arm_stats(e, 1));
+
+        // The always-valid p-value is the running minimum over all looks
+        double best = e.best_p_value.load(std::memory_order_relaxed);
+        while (result.p_value < best && !e.best_p_value.compare_exchange_weak(best, result.p_value)) {}
+        result.p_value = std::min(result.p_value, best);
+
+        int expected = static_cast<int>(SequentialResult::Verdict::Continue);
+        if (result.verdict != SequentialResult::Verdict::Continue &&
+            e.verdict.compare_exchange_strong(expected, static_cast<int>(result.verdict))) {
+            e.stopped_at.store(result.samples, std::memory_order_release);
+        }
+        result.verdict = verdict(experiment);
+        return result;
+    }
+
+    SequentialResult::Verdict verdict(size_t experiment) const {
+        return static_cast<SequentialResult::Verdict>(experiments[experiment].verdict.load(std::memory_order_acquire));
+    }
+
+    uint64_t stopped_at(size_t experiment) const {
+        return experiments[experiment].stopped_at.load(std::memory_order_acquire);
+    }
+
+    size_t size() const { return experiment_count; }
+
+private:
+    struct alignas(64) Slot { // One writer at a time, any number of readers
+        std::atomic<uint32_t> sequence{0};
+        std::atomic<uint64_t> count{0};
+        std::atomic<double> mean{0}, m2{0};
+    };
+
+    struct Experiment {
+        Slot arms[2][MAX_WRITERS];
+        std::atomic<double> best_p_value{1};
+        std::atomic<int> verdict{static_cast<int>(SequentialResult::Verdict::Continue)};
+        std::atomic<uint64_t> stopped_at{0};
+    };
+
+    static RunningStats arm_stats(const Experiment& e, int arm) {
+        RunningStats total;
+        for (const Slot& slot : e.arms[arm]) {
+            RunningStats part;
+            while (true) {
+                uint32_t before = slot.sequence.load(std::memory_order_acquire);
+                if (before & 1) { // Writer mid-update
+                    std::this_thread::yield();
+                    continue;
+                }
+                part.count = slot.count.load(std::memory_order_relaxed);
+                part.mean = slot.mean.load(std::memory_order_relaxed);
+                part.m2 = slot.m2.load(std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (slot.sequence.load(std::memory_order_relaxed) == before) break;
+            }
+            total.merge(part);
+        }
+        return total;
+    }
+
+    std::unique_ptr<Experiment[]> experiments;
+    size_t experiment_count;
+    MixtureSPRT test;
 };
 
 int main() {
-    // Simulate user engagement data (e.g., time spent) for two content variants
-    std::vector<int> allUsers(10000);
-    std::generate(allUsers.begin(), allUsers.end(), [](){ return rand() % 100; });
-    
-    ABSampler sampler(allUsers);
+    // Stream user engagement (e.g., time spent) tagged by device type;
+    // mobile users are many but steady, desktop users few but spread out
+    ABSampler sampler(1000, ABSampler::Allocation::Neyman);
+    Xoshiro256 traffic(42);
+    for (int user = 0; user < 1000000; ++user) {
+        int device = user % 10 < 7 ? 0 : (user % 10 < 9 ? 1 : 2);
+        int spread = device == 0 ? 10 : (device == 1 ? 30 : 90);
+        sampler.observe(device, 40 + static_cast<int>(traffic.below(spread)));
+    }
+
     auto sampleA = sampler.get_sample(500); // Small representative sample
     auto sampleB = sampler.get_sample(500);
-    
+
+    // Neyman draws oversample the spread-out strata: only the weighted mean
+    // estimates the population (about 50.5 here)
+    double raw = 0, weighted = 0, total_weight = 0;
+    for (const auto& [value, weight] : sampleA) {
+        raw += value;
+        weighted += weight * value;
+        total_weight += weight;
+    }
+    std::cout << "Mean engagement: " << raw / sampleA.size() << " unweighted, "
+              << weighted / total_weight << " weighted\n";
+
     // Can make early decisions without waiting for full population
-    if (sampler.should_terminate_early(sampleA, sampleB, 10.0)) {
+    MixtureSPRT test(0.05, 2.0);
+    if (sampler.should_terminate_early(sampleA, sampleB, test)) {
         std::cout << "Significant difference detected - early termination possible\n";
+    } else {
+        std::cout << "No significant difference in " << sampleA.size() << "-user samples\n";
     }
-    
+
+    // 2000 live experiments: half A/A (no true effect), half where B adds
+    // +1 to engagement. Ingest threads stream users while a monitor thread
+    // peeks at every experiment continuously.
+    const size_t experiments = 2000;
+    // More ingest threads than slots per arm: writers share slots as needed
+    const int writers = 20, users_per_writer = 400000;
+    ExperimentEngine engine(experiments, test);
+    std::atomic<bool> done{false};
+    std::vector<std::thread> ingest;
+    for (int w = 0; w < writers; ++w) {
+        ingest.emplace_back([&, w]() {
+            Xoshiro256 rng(1000 + w);
+            for (int i = 0; i < users_per_writer; ++i) {
+                size_t e = rng.below(experiments);
+                if (engine.verdict(e) != SequentialResult::Verdict::Continue) continue; // Stopped
+                int arm = static_cast<int>(rng.below(2));
+                double lift = (e % 2 == 1 && arm == 1) ? 1.0 : 0.0;
+                double noise = (rng.uniform() + rng.uniform() + rng.uniform() - 1.5) * 20; // sd 10
+                engine.record(e, arm, 50 + lift + noise);
+            }
+        });
+    }
+    std::thread monitor([&]() {
+        while (!done.load())
+            for (size_t e = 0; e < experiments; ++e) engine.evaluate(e);
+    });
+    for (auto& t : ingest) t.join();
+    done = true;
+    monitor.join();
+
+    size_t false_stops = 0, detections = 0;
+    uint64_t samples_at_detection = 0;
+    for (size_t e = 0; e < experiments; ++e) {
+        auto verdict = engine.evaluate(e).verdict;
+        if (verdict == SequentialResult::Verdict::Continue) continue;
+        if (e % 2 == 0) {
+            ++false_stops;
+        } else if (verdict == SequentialResult::Verdict::VariantB) {
+            ++detections;
+            samples_at_detection += engine.stopped_at(e);
+        }
+    }
+    std::cout << "A/A experiments stopped (false positives): " << false_stops << " of " << experiments / 2 << "\n";
+    std::cout << "A/B experiments detected: " << detections << " of " << experiments / 2;
+    if (detections) std::cout << ", after " << samples_at_detection / detections << " users on average";
+    std::cout << "\n";
+
     return 0;
-}
\ No newline at end of file
+}
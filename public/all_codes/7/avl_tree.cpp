@@ -1,124 +1,343 @@
 #include <iostream>
 #include <algorithm>
+#include <vector>
+#include <string>
+#include <optional>
+#include <unordered_map>
+#include <cstdint>
+#include <stdexcept>
 using namespace std;
 
-class AVLNode {
-public:
-    int priority; // Lower value = higher priority
-    string taskId;
-    AVLNode *left, *right;
-    int height;
+// Localization task queue as an AVL tree over pooled, index-linked nodes.
+// Keys are (priority, arrival) so equal priorities coexist in FIFO order,
+// the minimum is cached for O(1) peeks, and a taskId -> node index makes
+// pop, removal and reprioritization O(log n). Subtree sizes add order
+// statistics: rank(), select() and allocation-free range walks.
+class AVLTree {
+    static constexpr uint32_t NIL = UINT32_MAX;
 
-    AVLNode(int p, string id) : priority(p), taskId(id), left(nullptr), right(nullptr), height(1) {}
-};
+    // Hot fields only; task names live in a parallel array
+    struct AVLNode {
+        int priority; // Lower value = higher priority
+        uint64_t arrival;
+        uint32_t left, right;
+        int height;
+        uint32_t size;    // Nodes in this subtree
+    };
 
-class AVLTree {
-    AVLNode* root;
+    vector<AVLNode> nodes;          // Slab of nodes, recycled through freeSlots
+    vector<string> taskIds;         // taskIds[i] belongs to nodes[i]
+    vector<uint32_t> freeSlots;
+    unordered_map<string, uint32_t> handles;
+    uint32_t root = NIL;
+    uint32_t minNode = NIL;
+    uint64_t nextArrival = 0;
 
-    int height(AVLNode* node) {
-        return node ? node->height : 0;
+    int height(uint32_t node) const {
+        return node != NIL ? nodes[node].height : 0;
     }
 
-    int balanceFactor(AVLNode* node) {
-        return node ? height(node->left) - height(node->right) : 0;
+    int balanceFactor(uint32_t node) const {
+        return node != NIL ? height(nodes[node].left) - height(nodes[node].right) : 0;
     }
 
-    AVLNode* rightRotate(AVLNode* y) {
-        AVLNode* x = y->left;
-        AVLNode* T2 = x->right;
+    bool before(uint32_t a, uint32_t b) const {
+        if (nodes[a].priority != nodes[b].priority) return nodes[a].priority < nodes[b].priority;
+        return nodes[a].arrival < nodes[b].arrival;
+    }
 
-        x->right = y;
-        y->left = T2;
+    uint32_t subtreeSize(uint32_t node) const {
+        return node != NIL ? nodes[node].size : 0;
+    }
 
-        y->height = max(height(y->left), height(y->right)) + 1;
-        x->height = max(height(x->left), height(x->right)) + 1;
+    void update(uint32_t node) {
+        nodes[node].height = max(height(nodes[node].left), height(nodes[node].right)) + 1;
+        nodes[node].size = subtreeSize(nodes[node].left) + subtreeSize(nodes[node].right) + 1;
+    }
 
+    uint32_t rightRotate(uint32_t y) {
+        uint32_t x = nodes[y].left;
+        nodes[y].left = nodes[x].right;
+        nodes[x].right = y;
+        update(y);
+        update(x);
         return x;
     }
 
-    AVLNode* leftRotate(AVLNode* x) {
-        AVLNode* y = x->right;
-        AVLNode* T2 = y->left;
-
-        y->left = x;
-        x->right = T2;
-
-        x->height = max(height(x->left), height(x->right)) + 1;
-        y->height = max(height(y->left), height(y->right)) + 1;
-
+    uint32_t leftRotate(uint32_t x) {
+        uint32_t y = nodes[x].right;
+        nodes[x].right = nodes[y].left;
+        nodes[y].left = x;
+        update(x);
+        update(y);
         return y;
     }
 
-    AVLNode* insert(AVLNode* node, int priority, string taskId) {
-        if (!node) return new AVLNode(priority, taskId);
-
-        if (priority < node->priority)
-            node->left = insert(node->left, priority, taskId);
-        else if (priority > node->priority)
-            node->right = insert(node->right, priority, taskId);
-        else
-            return node; // Equal priorities not allowed
-
-        node->height = 1 + max(height(node->left), height(node->right));
-
+    uint32_t rebalance(uint32_t node) {
+        update(node);
         int balance = balanceFactor(node);
 
-        // Left Left Case
-        if (balance > 1 && priority < node->left->priority)
+        if (balance > 1) {
+            // Left Right Case
+            if (balanceFactor(nodes[node].left) < 0)
+                nodes[node].left = leftRotate(nodes[node].left);
+            // Left Left Case
             return rightRotate(node);
-
-        // Right Right Case
-        if (balance < -1 && priority > node->right->priority)
+        }
+        if (balance < -1) {
+            // Right Left Case
+            if (balanceFactor(nodes[node].right) > 0)
+                nodes[node].right = rightRotate(nodes[node].right);
+            // Right Right Case
             return leftRotate(node);
+        }
+        return node;
+    }
 
-        // Left Right Case
-        if (balance > 1 && priority > node->left->priority) {
-            node->left = leftRotate(node->left);
-            return rightRotate(node);
+    uint32_t insert(uint32_t node, uint32_t fresh) {
+        if (node == NIL) return fresh;
+
+        if (before(fresh, node))
+            nodes[node].left = insert(nodes[node].left, fresh);
+        else
+            nodes[node].right = insert(nodes[node].right, fresh);
+
+        return rebalance(node);
+    }
+
+    // Unlinks the leftmost node of the subtree into `removed`
+    uint32_t detachMin(uint32_t node, uint32_t& removed) {
+        if (nodes[node].left == NIL) {
+            removed = node;
+            return nodes[node].right;
         }
+        nodes[node].left = detachMin(nodes[node].left, removed);
+        return rebalance(node);
+    }
 
-        // Right Left Case
-        if (balance < -1 && priority < node->right->priority) {
-            node->right = rightRotate(node->right);
-            return leftRotate(node);
+    // Unlinks `target` while keeping its slot (handles point at it)
+    uint32_t detach(uint32_t node, uint32_t target) {
+        if (node == target) {
+            uint32_t left = nodes[node].left, right = nodes[node].right;
+            if (right == NIL) return left;
+            uint32_t successor;
+            right = detachMin(right, successor);
+            nodes[successor].left = left;
+            nodes[successor].right = right;
+            return rebalance(successor);
         }
+        if (before(target, node))
+            nodes[node].left = detach(nodes[node].left, target);
+        else
+            nodes[node].right = detach(nodes[node].right, target);
+        return rebalance(node);
+    }
 
+    uint32_t minValueNode(uint32_t node) const {
+        if (node == NIL) return NIL;
+        while (nodes[node].left != NIL)
+            node = nodes[node].left;
         return node;
     }
 
-    AVLNode* minValueNode(AVLNode* node) {
-        AVLNode* current = node;
-        while (current->left)
-            current = current->left;
-        return current;
+    void link(uint32_t slot, int priority) {
+        nodes[slot] = {priority, nextArrival++, NIL, NIL, 1, 1};
+        root = insert(root, slot);
+        if (minNode == NIL || before(slot, minNode)) minNode = slot;
+    }
+
+    void unlink(uint32_t slot) {
+        root = detach(root, slot);
+        if (slot == minNode) minNode = minValueNode(root);
+    }
+
+    // Perfectly balanced subtree over slots [lo, hi), already in key order
+    uint32_t buildBalanced(uint32_t lo, uint32_t hi) {
+        if (lo >= hi) return NIL;
+        uint32_t mid = lo + (hi - lo) / 2;
+        nodes[mid].left = buildBalanced(lo, mid);
+        nodes[mid].right = buildBalanced(mid + 1, hi);
+        update(mid);
+        return mid;
+    }
+
+    template <typename Visit>
+    void visitRange(uint32_t node, int low, int high, Visit& visit) const {
+        if (node == NIL) return;
+        int p = nodes[node].priority;
+        if (p >= low) visitRange(nodes[node].left, low, high, visit);
+        if (p >= low && p <= high) visit(nodes[node].priority, taskIds[node]);
+        if (p <= high) visitRange(nodes[node].right, low, high, visit);
     }
 
 public:
-    AVLTree() : root(nullptr) {}
+    struct Task {
+        int priority;
+        string taskId;
+    };
+
+    void reserve(size_t tasks) {
+        nodes.reserve(tasks);
+        taskIds.reserve(tasks);
+        handles.reserve(tasks);
+    }
 
+    // Adding a taskId that is already queued reprioritizes it instead
     void addTask(int priority, string taskId) {
-        root = insert(root, priority, taskId);
+        if (changePriority(taskId, priority)) return;
+
+        uint32_t slot;
+        if (!freeSlots.empty()) {
+            slot = freeSlots.back();
+            freeSlots.pop_back();
+            taskIds[slot] = move(taskId);
+        } else {
+            slot = static_cast<uint32_t>(nodes.size());
+            nodes.push_back({});
+            taskIds.push_back(move(taskId));
+        }
+        handles.emplace(taskIds[slot], slot);
+        link(slot, priority);
+    }
+
+    // O(1): the minimum is cached
+    string getHighestPriorityTask() const {
+        if (minNode == NIL) return "No tasks";
+        return taskIds[minNode] + " (Priority: " + to_string(nodes[minNode].priority) + ")";
+    }
+
+    optional<Task> popHighestPriorityTask() {
+        if (minNode == NIL) return nullopt;
+        uint32_t slot = minNode;
+        Task task{nodes[slot].priority, move(taskIds[slot])};
+        unlink(slot);
+        handles.erase(task.taskId);
+        freeSlots.push_back(slot);
+        return task;
     }
 
-    string getHighestPriorityTask() {
-        if (!root) return "No tasks";
-        AVLNode* minNode = minValueNode(root);
-        return minNode->taskId + " (Priority: " + to_string(minNode->priority) + ")";
+    bool changePriority(const string& taskId, int newPriority) {
+        auto it = handles.find(taskId);
+        if (it == handles.end()) return false;
+        unlink(it->second);
+        link(it->second, newPriority); // Re-queued behind equal priorities
+        return true;
+    }
+
+    bool removeTask(const string& taskId) {
+        auto it = handles.find(taskId);
+        if (it == handles.end()) return false;
+        uint32_t slot = it->second;
+        unlink(slot);
+        handles.erase(it);
+        taskIds[slot].clear();
+        freeSlots.push_back(slot);
+        return true;
+    }
+
+    // Tasks strictly more urgent than priority p, O(log n)
+    size_t rank(int p) const {
+        size_t count = 0;
+        for (uint32_t node = root; node != NIL;) {
+            if (nodes[node].priority < p) {
+                count += subtreeSize(nodes[node].left) + 1;
+                node = nodes[node].right;
+            } else {
+                node = nodes[node].left;
+            }
+        }
+        return count;
+    }
+
+    // The k-th task in dispatch order (0 = next to run), O(log n)
+    optional<Task> select(size_t k) const {
+        if (k >= size()) return nullopt;
+        uint32_t node = root;
+        while (true) {
+            size_t leftSize = subtreeSize(nodes[node].left);
+            if (k < leftSize) {
+                node = nodes[node].left;
+            } else if (k == leftSize) {
+                return Task{nodes[node].priority, taskIds[node]};
+            } else {
+                k -= leftSize + 1;
+                node = nodes[node].right;
+            }
+        }
     }
+
+    // Calls visit(priority, taskId) for every task with priority in
+    // [low, high], in dispatch order. O(log n + matches), no allocation.
+    template <typename Visit>
+    void forEachInRange(int low, int high, Visit visit) const {
+        visitRange(root, low, high, visit);
+    }
+
+    // Replaces the queue with tasks already sorted by priority in O(n):
+    // slots are laid out in order and linked as a balanced tree, no rotations
+    void bulkLoad(vector<Task> sorted) {
+        if (!is_sorted(sorted.begin(), sorted.end(),
+                       [](const Task& a, const Task& b) { return a.priority < b.priority; }))
+            throw invalid_argument("bulkLoad expects tasks sorted by priority");
+
+        // Validate into fresh containers so a bad batch leaves the queue intact
+        vector<string> ids;
+        unordered_map<string, uint32_t> index;
+        ids.reserve(sorted.size());
+        index.reserve(sorted.size());
+        for (uint32_t i = 0; i < sorted.size(); i++) {
+            ids.push_back(move(sorted[i].taskId));
+            if (!index.emplace(ids[i], i).second)
+                throw invalid_argument("bulkLoad got duplicate taskId " + ids[i]);
+        }
+
+        nodes.assign(sorted.size(), {});
+        for (uint32_t i = 0; i < sorted.size(); i++)
+            nodes[i] = {sorted[i].priority, nextArrival++, NIL, NIL, 1, 1};
+        taskIds = move(ids);
+        handles = move(index);
+        freeSlots.clear();
+        root = buildBalanced(0, static_cast<uint32_t>(nodes.size()));
+        minNode = minValueNode(root);
+    }
+
+    size_t size() const { return handles.size(); }
+    bool empty() const { return handles.empty(); }
 };
 
 int main() {
     AVLTree taskQueue;
-    
+
     // Adding localization tasks with priorities
     // Lower priority number = higher urgency
     taskQueue.addTask(3, "Localize ad campaign for Germany");
     taskQueue.addTask(1, "URGENT: Fix lip-sync for Japanese dub");
     taskQueue.addTask(2, "Update Spanish subtitles for movie");
     taskQueue.addTask(5, "Standard localization for French market");
-    
+    taskQueue.addTask(2, "Update Portuguese subtitles for movie"); // Same priority is kept
+
     // Getting the highest priority task (lowest number)
     cout << "Next task to process: " << taskQueue.getHighestPriorityTask() << endl;
-    
+
+    // Dispatcher queries on the current queue
+    cout << "Tasks more urgent than priority 3: " << taskQueue.rank(3) << endl;
+    cout << "Third task in line: " << taskQueue.select(2)->taskId << endl;
+    cout << "Tasks with priority in [2, 3]:" << endl;
+    taskQueue.forEachInRange(2, 3, [](int priority, const string& taskId) {
+        cout << "  " << taskId << " (Priority: " << priority << ")" << endl;
+    });
+
+    // The French release date moved up
+    taskQueue.changePriority("Standard localization for French market", 0);
+
+    // Workers drain the queue in priority order
+    while (auto task = taskQueue.popHighestPriorityTask()) {
+        cout << "Processing: " << task->taskId << " (Priority: " << task->priority << ")" << endl;
+    }
+
+    // Nightly rebuild from an already sorted export
+    taskQueue.bulkLoad({{1, "Dub review: Korean"}, {2, "Subtitle QA: Italian"}, {4, "Artwork: Brazil"}});
+    cout << "After nightly rebuild, next task: " << taskQueue.getHighestPriorityTask() << endl;
+
     return 0;
-}
\ No newline at end of file
+}
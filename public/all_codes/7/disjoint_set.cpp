@@ -1,69 +1,176 @@
 #include <iostream>
 #include <vector>
-#include <unordered_map>
+#include <string>
+#include <string_view>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
 using namespace std;
 
+// Subtitle segments are interned into dense ids, so a group costs a few bytes
+// per segment in flat arrays instead of two string-keyed hash maps.
+// Unions are by rank without path compression: find() stays O(log n) and
+// every union is a single undo-log entry that rollback() can reverse in O(1).
 class SubtitleGroupManager {
-    unordered_map<string, string> parent;
-    unordered_map<string, int> rank;
+    static constexpr uint32_t NONE = UINT32_MAX;
+
+    // Interning: all names packed in one arena, looked up through an
+    // open-addressing table of ids (no per-string heap allocation)
+    vector<char> nameArena;
+    vector<uint32_t> nameStart;   // id -> offset into nameArena, plus end sentinel
+    vector<uint32_t> table;       // Open-addressing slots holding ids, NONE if empty
+
+    vector<uint32_t> parent;
+    vector<uint8_t> rank;         // Union by rank keeps ranks below 32
+
+    struct UndoEntry {
+        uint32_t child;           // Root that was linked under another root
+        uint32_t newRoot;
+        bool rankBumped;
+    };
+    vector<UndoEntry> undoLog;
+
+    string_view nameOf(uint32_t id) const {
+        return string_view(nameArena.data() + nameStart[id], nameStart[id + 1] - nameStart[id]);
+    }
+
+    size_t slotFor(string_view name) const {
+        size_t mask = table.size() - 1;
+        size_t i = hash<string_view>{}(name) & mask;
+        while (table[i] != NONE && nameOf(table[i]) != name)
+            i = (i + 1) & mask;
+        return i;
+    }
+
+    void growTable() {
+        vector<uint32_t> old(table.size() * 2, NONE);
+        old.swap(table);
+        for (uint32_t id : old)
+            if (id != NONE) table[slotFor(nameOf(id))] = id;
+    }
+
+    uint32_t lookup(string_view name) const {
+        return table[slotFor(name)];
+    }
 
 public:
-    void makeSet(const string& subtitleId) {
-        parent[subtitleId] = subtitleId;
-        rank[subtitleId] = 0;
+    using Checkpoint = size_t;
+
+    SubtitleGroupManager() : nameStart{0}, table(16, NONE) {}
+
+    // Reserve space up front when the segment count is known
+    void reserve(size_t segments, size_t totalNameBytes) {
+        nameArena.reserve(totalNameBytes);
+        nameStart.reserve(segments + 1);
+        parent.reserve(segments);
+        rank.reserve(segments);
+        while (table.size() < 2 * segments) growTable();
+    }
+
+    uint32_t makeSet(const string& subtitleId) {
+        size_t slot = slotFor(subtitleId);
+        if (table[slot] != NONE) return table[slot];
+
+        // 32-bit arena offsets and ids: refuse before anything would wrap
+        if (nameArena.size() + subtitleId.size() > UINT32_MAX)
+            throw length_error("SubtitleGroupManager name arena exceeds 4 GiB");
+        if (parent.size() >= NONE) throw length_error("SubtitleGroupManager id space exhausted");
+        uint32_t id = static_cast<uint32_t>(parent.size());
+        nameArena.insert(nameArena.end(), subtitleId.begin(), subtitleId.end());
+        nameStart.push_back(static_cast<uint32_t>(nameArena.size()));
+        parent.push_back(id);
+        rank.push_back(0);
+        table[slot] = id;
+        if (2 * parent.size() > table.size()) growTable();
+        return id;
+    }
+
+    uint32_t find(uint32_t id) const {
+        while (parent[id] != id) id = parent[id];
+        return id;
     }
 
-    string find(const string& subtitleId) {
-        if (parent[subtitleId] != subtitleId)
-            parent[subtitleId] = find(parent[subtitleId]); // Path compression
-        return parent[subtitleId];
+    // Representative segment of the group, or "" for an unknown segment.
+    // Returned by value: makeSet() may reallocate the name arena.
+    string find(const string& subtitleId) const {
+        uint32_t id = lookup(subtitleId);
+        return id == NONE ? string() : string(nameOf(find(id)));
     }
 
     void unionSets(const string& a, const string& b) {
-        string rootA = find(a);
-        string rootB = find(b);
+        uint32_t rootA = find(makeSet(a));
+        uint32_t rootB = find(makeSet(b));
 
         if (rootA == rootB) return;
 
         // Union by rank
-        if (rank[rootA] > rank[rootB]) {
-            parent[rootB] = rootA;
-        } else {
-            parent[rootA] = rootB;
-            if (rank[rootA] == rank[rootB])
-                rank[rootB]++;
+        if (rank[rootA] > rank[rootB]) swap(rootA, rootB);
+        bool bump = rank[rootA] == rank[rootB];
+        parent[rootA] = rootB;
+        if (bump) rank[rootB]++;
+        undoLog.push_back({rootA, rootB, bump});
+    }
+
+    bool areConnected(const string& a, const string& b) const {
+        uint32_t idA = lookup(a), idB = lookup(b);
+        if (idA == NONE || idB == NONE) return a == b;
+        return find(idA) == find(idB);
+    }
+
+    // Marks the current alignment state; pass it to rollback() to revert
+    Checkpoint checkpoint() const {
+        return undoLog.size();
+    }
+
+    // Undoes every union made since the checkpoint, O(1) each.
+    // Segments registered since then stay interned as singletons.
+    void rollback(Checkpoint cp) {
+        while (undoLog.size() > cp) {
+            const UndoEntry& e = undoLog.back();
+            parent[e.child] = e.child;
+            if (e.rankBumped) rank[e.newRoot]--;
+            undoLog.pop_back();
         }
     }
 
-    bool areConnected(const string& a, const string& b) {
-        return find(a) == find(b);
+    size_t segmentCount() const {
+        return parent.size();
     }
 };
 
 int main() {
     SubtitleGroupManager manager;
-    
+
     // Create subtitle segments for different languages
     vector<string> englishSegments = {"en_seg1", "en_seg2", "en_seg3"};
     vector<string> spanishSegments = {"es_seg1", "es_seg2", "es_seg3"};
     vector<string> japaneseSegments = {"jp_seg1", "jp_seg2", "jp_seg3"};
-    
+
     // Initialize all segments
     for (const auto& seg : englishSegments) manager.makeSet(seg);
     for (const auto& seg : spanishSegments) manager.makeSet(seg);
     for (const auto& seg : japaneseSegments) manager.makeSet(seg);
-    
+
     // Connect corresponding segments across languages
     for (int i = 0; i < 3; i++) {
         manager.unionSets(englishSegments[i], spanishSegments[i]);
         manager.unionSets(englishSegments[i], japaneseSegments[i]);
     }
-    
+
     // Verify connections
-    cout << "Are segment 1 translations connected? " 
+    cout << "Are segment 1 translations connected? "
          << (manager.areConnected("en_seg1", "jp_seg1") ? "Yes" : "No") << endl;
-    cout << "Are segment 1 and 2 connected across languages? " 
+    cout << "Are segment 1 and 2 connected across languages? "
          << (manager.areConnected("en_seg1", "es_seg2") ? "Yes" : "No") << endl;
-    
+
+    // An editor tries merging segments 1 and 2, then reverts the edit
+    auto beforeEdit = manager.checkpoint();
+    manager.unionSets("en_seg1", "en_seg2");
+    cout << "After trial alignment, segment 1 and 2 connected? "
+         << (manager.areConnected("jp_seg1", "es_seg2") ? "Yes" : "No") << endl;
+    manager.rollback(beforeEdit);
+    cout << "After rollback, segment 1 and 2 connected? "
+         << (manager.areConnected("jp_seg1", "es_seg2") ? "Yes" : "No") << endl;
+
     return 0;
-}
\ No newline at end of file
+}
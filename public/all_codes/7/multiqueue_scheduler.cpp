@@ -0,0 +1,259 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <optional>
+#include <climits>
+#include <cstdint>
+#include <memory>
+using namespace std;
+
+// Relaxed concurrent priority scheduler (MultiQueue) for localization workers.
+// c*P sequential heaps, each behind its own try-lock. Push goes to a random
+// shard; pop peeks two random shards and takes the better top. Workers never
+// wait on a held lock, they just sample again, so throughput scales with
+// threads while pops stay close to the true minimum.
+class MultiQueueScheduler {
+public:
+    struct Task {
+        int priority; // Lower value = higher priority
+        uint32_t taskId;
+    };
+
+private:
+    // Tops are widened to 64 bits so "empty" is never a real int priority
+    static constexpr int64_t EMPTY_TOP = INT64_MAX;
+
+    struct alignas(64) Shard {
+        atomic<bool> locked{false};
+        atomic<int64_t> top{EMPTY_TOP}; // Cached best priority, readable without the lock
+        vector<Task> heap;              // Binary min-heap on priority
+
+        bool tryLock() {
+            return !locked.load(memory_order_relaxed) &&
+                   !locked.exchange(true, memory_order_acquire);
+        }
+        void unlock() { locked.store(false, memory_order_release); }
+        void publishTop() {
+            top.store(heap.empty() ? EMPTY_TOP : heap.front().priority, memory_order_relaxed);
+        }
+    };
+
+    static bool worse(const Task& a, const Task& b) { return a.priority > b.priority; }
+
+    size_t shardCount;
+    unique_ptr<Shard[]> shards;
+
+    // xorshift64*, one stream per thread
+    static uint64_t nextRandom() {
+        thread_local uint64_t state =
+            0x9E3779B97F4A7C15ULL ^ hash<thread::id>{}(this_thread::get_id());
+        state ^= state >> 12;
+        state ^= state << 25;
+        state ^= state >> 27;
+        return state * 0x2545F4914F6CDD1DULL;
+    }
+
+    size_t randomShard() { return nextRandom() % shardCount; }
+
+public:
+    // c = shards per worker thread; 2 to 4 is the usual quality/throughput balance
+    MultiQueueScheduler(size_t workers, size_t c = 2)
+        : shardCount(max<size_t>(2, workers * c)), shards(make_unique<Shard[]>(shardCount)) {}
+
+    // Calls `onLocked` while the chosen shard is held, e.g. to stamp the op
+    template <typename OnLocked>
+    void push(Task task, OnLocked&& onLocked) {
+        while (true) {
+            Shard& shard = shards[randomShard()];
+            if (!shard.tryLock()) continue;
+            shard.heap.push_back(task);
+            push_heap(shard.heap.begin(), shard.heap.end(), worse);
+            onLocked(task);
+            shard.publishTop();
+            shard.unlock();
+            return;
+        }
+    }
+
+    void push(Task task) {
+        push(task, [](const Task&) {});
+    }
+
+    template <typename OnLocked>
+    optional<Task> pop(OnLocked&& onLocked) {
+        size_t emptySamples = 0;
+        while (true) {
+            size_t a = randomShard(), b = randomShard();
+            int64_t topA = shards[a].top.load(memory_order_relaxed);
+            int64_t topB = shards[b].top.load(memory_order_relaxed);
+            Shard& shard = shards[topA <= topB ? a : b];
+
+            if (min(topA, topB) == EMPTY_TOP) {
+                // Sampling keeps missing: confirm emptiness with a full sweep
+                if (++emptySamples < 2 * shardCount) continue;
+                bool anyTask = false;
+                for (size_t i = 0; i < shardCount && !anyTask; i++)
+                    anyTask = shards[i].top.load(memory_order_relaxed) != EMPTY_TOP;
+                if (!anyTask) return nullopt;
+                emptySamples = 0;
+                continue;
+            }
+            if (!shard.tryLock()) continue;
+            if (shard.heap.empty()) {
+                shard.unlock();
+                continue;
+            }
+            pop_heap(shard.heap.begin(), shard.heap.end(), worse);
+            Task task = shard.heap.back();
+            shard.heap.pop_back();
+            onLocked(task);
+            shard.publishTop();
+            shard.unlock();
+            return task;
+        }
+    }
+
+    optional<Task> pop() {
+        return pop([](const Task&) {});
+    }
+};
+
+// Counts queued tasks per priority so a replayed pop can be ranked
+class FenwickCounter {
+    vector<int64_t> tree;
+
+public:
+    explicit FenwickCounter(size_t n) : tree(n + 1, 0) {}
+    void add(size_t i, int64_t delta) {
+        for (i++; i < tree.size(); i += i & -i) tree[i] += delta;
+    }
+    int64_t prefix(size_t i) const { // Sum over [0, i)
+        int64_t sum = 0;
+        for (; i > 0; i -= i & -i) sum += tree[i];
+        return sum;
+    }
+};
+
+struct BenchmarkResult {
+    double mopsPerSecond;
+    double meanRankError;
+    int64_t maxRankError;
+};
+
+// Each worker alternates push/pop on a prefilled queue. The timed run has no
+// instrumentation; a second run stamps every op with a global sequence number
+// under the shard lock, and replaying those stamps in order measures how many
+// strictly better tasks were queued when each pop happened (0 = exact).
+// With more threads than cores, a worker preempted inside a shard hides that
+// shard's best tasks, so rank error there reflects oversubscription.
+static BenchmarkResult benchmark(size_t threads, size_t opsPerThread, size_t prefill) {
+    constexpr int PRIORITIES = 1 << 16;
+    auto runWorkers = [&](auto&& work) {
+        vector<thread> workers;
+        for (size_t t = 0; t < threads; t++) workers.emplace_back(work, t);
+        for (auto& w : workers) w.join();
+    };
+    auto fill = [&](MultiQueueScheduler& queue, auto&& stamp) {
+        for (size_t i = 0; i < prefill; i++)
+            queue.push({int(i * 7919 % PRIORITIES), uint32_t(i)}, stamp);
+    };
+
+    BenchmarkResult result{};
+    {
+        MultiQueueScheduler queue(threads);
+        fill(queue, [](const MultiQueueScheduler::Task&) {});
+        auto start = chrono::steady_clock::now();
+        runWorkers([&](size_t t) {
+            uint32_t seed = uint32_t(t * 2654435761u + 1);
+            for (size_t i = 0; i < opsPerThread; i++) {
+                seed = seed * 1664525u + 1013904223u;
+                if (i & 1) queue.pop();
+                else queue.push({int(seed >> 16) % PRIORITIES, seed});
+            }
+        });
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        result.mopsPerSecond = threads * opsPerThread / seconds / 1e6;
+    }
+
+    struct Stamp {
+        uint64_t sequence;
+        int priority;
+        bool isPop;
+    };
+    atomic<uint64_t> clock{0};
+    vector<vector<Stamp>> logs(threads + 1);
+    {
+        MultiQueueScheduler queue(threads);
+        fill(queue, [&](const MultiQueueScheduler::Task& task) {
+            logs[threads].push_back({clock.fetch_add(1), task.priority, false});
+        });
+        runWorkers([&](size_t t) {
+            auto& log = logs[t];
+            log.reserve(opsPerThread);
+            uint32_t seed = uint32_t(t * 2654435761u + 1);
+            for (size_t i = 0; i < opsPerThread; i++) {
+                seed = seed * 1664525u + 1013904223u;
+                auto stamp = [&](bool isPop) {
+                    return [&, isPop](const MultiQueueScheduler::Task& task) {
+                        log.push_back({clock.fetch_add(1, memory_order_relaxed), task.priority, isPop});
+                    };
+                };
+                if (i & 1) queue.pop(stamp(true));
+                else queue.push({int(seed >> 16) % PRIORITIES, seed}, stamp(false));
+            }
+        });
+    }
+
+    vector<Stamp> replay;
+    for (auto& log : logs) replay.insert(replay.end(), log.begin(), log.end());
+    sort(replay.begin(), replay.end(), [](const Stamp& a, const Stamp& b) { return a.sequence < b.sequence; });
+    FenwickCounter queued(PRIORITIES);
+    int64_t totalError = 0, pops = 0;
+    for (const Stamp& s : replay) {
+        if (!s.isPop) {
+            queued.add(s.priority, 1);
+            continue;
+        }
+        int64_t error = queued.prefix(s.priority);
+        queued.add(s.priority, -1);
+        totalError += error;
+        result.maxRankError = max(result.maxRankError, error);
+        pops++;
+    }
+    result.meanRankError = pops ? double(totalError) / pops : 0;
+    return result;
+}
+
+int main() {
+    const vector<string> taskNames = {
+        "Localize ad campaign for Germany",
+        "URGENT: Fix lip-sync for Japanese dub",
+        "Update Spanish subtitles for movie",
+        "Standard localization for French market",
+        "Archive old subtitle drafts"
+    };
+    const vector<int> priorities = {3, 1, 2, 5, INT_MAX}; // Even INT_MAX gets scheduled
+
+    // Several localization workers share one scheduler; pops come out in
+    // near (not strict) priority order, which is the price of never blocking
+    MultiQueueScheduler scheduler(4);
+    for (uint32_t i = 0; i < taskNames.size(); i++) scheduler.push({priorities[i], i});
+    while (auto task = scheduler.pop()) {
+        cout << "Worker picked: " << taskNames[task->taskId]
+             << " (Priority: " << task->priority << ")" << endl;
+    }
+
+    cout << "\nthreads   Mops/s   mean rank error   max rank error" << endl;
+    for (size_t threads : {1, 2, 4, 8, 16, 32, 64}) {
+        BenchmarkResult r = benchmark(threads, 200000 / threads, 100000);
+        cout << setw(7) << threads << setw(9) << fixed << setprecision(2) << r.mopsPerSecond
+             << setw(18) << r.meanRankError << setw(17) << r.maxRankError << endl;
+    }
+
+    return 0;
+}
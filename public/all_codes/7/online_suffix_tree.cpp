@@ -0,0 +1,215 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <string_view>
+#include <memory>
+#include <algorithm>
+#include <cstdint>
+using namespace std;
+
+// Fixed-size blocks of nodes handed out by index. Growing never moves
+// existing nodes, so a long-running stream has no reallocation spikes.
+template <typename T, size_t BLOCK_BITS = 12>
+class NodePool {
+    static constexpr size_t BLOCK_SIZE = size_t(1) << BLOCK_BITS;
+    vector<unique_ptr<T[]>> blocks;
+    uint32_t used = 0;
+
+public:
+    uint32_t allocate() {
+        if ((used & (BLOCK_SIZE - 1)) == 0) blocks.push_back(make_unique<T[]>(BLOCK_SIZE));
+        return used++;
+    }
+
+    T& operator[](uint32_t i) { return blocks[i >> BLOCK_BITS][i & (BLOCK_SIZE - 1)]; }
+    const T& operator[](uint32_t i) const { return blocks[i >> BLOCK_BITS][i & (BLOCK_SIZE - 1)]; }
+    uint32_t size() const { return used; }
+};
+
+// Online suffix tree (Ukkonen) over an append-only metadata stream.
+// Edges are [start, end) ranges into one shared text buffer, leaves grow
+// implicitly with the text, and append() costs amortized O(chunk length),
+// so new metadata is searchable as soon as it arrives.
+class OnlineSuffixTree {
+    static constexpr uint32_t NONE = UINT32_MAX;
+    static constexpr uint32_t OPEN = UINT32_MAX; // Leaf edges end at the current text end
+
+    struct Node {
+        uint32_t start = 0, end = OPEN;
+        uint32_t suffixLink = 0;
+        uint32_t suffixStart = NONE;               // Leaves only
+        uint32_t firstChild = NONE, nextSibling = NONE;
+    };
+
+    string text;
+    NodePool<Node> nodes;
+    const uint32_t root;
+
+    // Active point: where the next extension starts
+    uint32_t activeNode = 0;
+    uint32_t activeEdge = 0;   // Text index of the first character on the active edge
+    uint32_t activeLength = 0;
+    uint32_t remainder = 0;    // Suffixes still implicit in the tree
+
+    uint32_t edgeEnd(uint32_t node) const {
+        return nodes[node].end == OPEN ? static_cast<uint32_t>(text.size()) : nodes[node].end;
+    }
+
+    uint32_t edgeLength(uint32_t node) const { return edgeEnd(node) - nodes[node].start; }
+
+    // Children form a sibling list: O(alphabet) lookup with no per-node map
+    uint32_t* childSlot(uint32_t node, char c) {
+        uint32_t* slot = &nodes[node].firstChild;
+        while (*slot != NONE && text[nodes[*slot].start] != c) slot = &nodes[*slot].nextSibling;
+        return slot;
+    }
+
+    uint32_t child(uint32_t node, char c) const {
+        uint32_t cur = nodes[node].firstChild;
+        while (cur != NONE && text[nodes[cur].start] != c) cur = nodes[cur].nextSibling;
+        return cur;
+    }
+
+    uint32_t newNode(uint32_t start, uint32_t end) {
+        uint32_t id = nodes.allocate();
+        nodes[id] = Node{};
+        nodes[id].start = start;
+        nodes[id].end = end;
+        nodes[id].suffixLink = root;
+        return id;
+    }
+
+    void addLeaf(uint32_t parent, uint32_t pos) {
+        uint32_t leaf = newNode(pos, OPEN);
+        nodes[leaf].suffixStart = pos - remainder + 1;
+        nodes[leaf].nextSibling = nodes[parent].firstChild;
+        nodes[parent].firstChild = leaf;
+    }
+
+    void extend(uint32_t pos) {
+        char c = text[pos];
+        uint32_t pendingLink = NONE;
+        remainder++;
+
+        while (remainder > 0) {
+            if (activeLength == 0) activeEdge = pos;
+            uint32_t* slot = childSlot(activeNode, text[activeEdge]);
+            uint32_t next = *slot;
+
+            if (next == NONE) {
+                addLeaf(activeNode, pos);
+                if (pendingLink != NONE) nodes[pendingLink].suffixLink = activeNode;
+                pendingLink = NONE;
+            } else {
+                uint32_t length = edgeLength(next);
+                if (activeLength >= length) { // Walk down past a whole edge
+                    activeEdge += length;
+                    activeLength -= length;
+                    activeNode = next;
+                    continue;
+                }
+                if (text[nodes[next].start + activeLength] == c) { // Already present
+                    if (pendingLink != NONE) nodes[pendingLink].suffixLink = activeNode;
+                    activeLength++;
+                    break;
+                }
+
+                // Split the edge and hang a new leaf off the split point
+                uint32_t split = newNode(nodes[next].start, nodes[next].start + activeLength);
+                *slot = split;
+                nodes[split].nextSibling = nodes[next].nextSibling;
+                nodes[next].nextSibling = NONE;
+                nodes[next].start += activeLength;
+                nodes[split].firstChild = next;
+                addLeaf(split, pos);
+                if (pendingLink != NONE) nodes[pendingLink].suffixLink = split;
+                pendingLink = split;
+            }
+
+            remainder--;
+            if (activeNode == root && activeLength > 0) {
+                activeLength--;
+                activeEdge = pos - remainder + 1;
+            } else {
+                activeNode = nodes[activeNode].suffixLink;
+            }
+        }
+    }
+
+public:
+    OnlineSuffixTree() : root(nodes.allocate()) {
+        nodes[root].end = 0;
+    }
+
+    // Extends the index with new metadata in amortized O(chunk.size())
+    void append(string_view chunk) {
+        text.reserve(text.size() + chunk.size());
+        for (char c : chunk) {
+            text.push_back(c);
+            extend(static_cast<uint32_t>(text.size() - 1));
+        }
+    }
+
+    // Start positions of every occurrence of pattern, in increasing order
+    vector<int> searchPattern(string_view pattern) const {
+        vector<int> positions;
+        if (pattern.empty()) return positions;
+
+        // Match the pattern along edges from the root
+        uint32_t node = root;
+        size_t matched = 0;
+        while (matched < pattern.size()) {
+            node = child(node, pattern[matched]);
+            if (node == NONE) return positions;
+            uint32_t start = nodes[node].start, end = edgeEnd(node);
+            for (uint32_t i = start; i < end && matched < pattern.size(); i++, matched++)
+                if (text[i] != pattern[matched]) return positions;
+        }
+
+        // Every leaf below the match point is an occurrence
+        vector<uint32_t> stack = {node};
+        while (!stack.empty()) {
+            uint32_t cur = stack.back();
+            stack.pop_back();
+            if (nodes[cur].suffixStart != NONE) positions.push_back(nodes[cur].suffixStart);
+            for (uint32_t c = nodes[cur].firstChild; c != NONE; c = nodes[c].nextSibling)
+                stack.push_back(c);
+        }
+
+        // The last `remainder` suffixes are still implicit and have no leaf yet
+        for (size_t start = text.size() - remainder; start < text.size(); start++)
+            if (text.compare(start, pattern.size(), pattern.data(), pattern.size()) == 0)
+                positions.push_back(static_cast<int>(start));
+
+        sort(positions.begin(), positions.end());
+        return positions;
+    }
+
+    size_t size() const { return text.size(); }
+    size_t nodeCount() const { return nodes.size(); }
+};
+
+int main() {
+    OnlineSuffixTree index;
+
+    // Metadata arrives in chunks from the ingestion stream
+    vector<string> stream = {
+        "us_ad_campaign,fr_movie_trailer,",
+        "es_tv_show,jp_ad_campaign,",
+        "us_movie,us_ad_retarget,"
+    };
+
+    for (const auto& chunk : stream) {
+        index.append(chunk);
+        cout << "After " << index.size() << " chars, ad campaigns at: ";
+        for (int pos : index.searchPattern("_ad_")) cout << pos << " ";
+        cout << endl;
+    }
+
+    cout << "US content found at positions: ";
+    for (int pos : index.searchPattern("us_")) cout << pos << " ";
+    cout << endl;
+    cout << "Suffix tree nodes: " << index.nodeCount() << endl;
+
+    return 0;
+}
@@ -1,65 +1,649 @@
 #include <iostream>
-#include <unordered_map>
 #include <vector>
+#include <string>
+#include <string_view>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
+#include <array>
+#include <queue>
+#include <tuple>
+#include <chrono>
+#include <random>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 using namespace std;
 
-class SuffixTreeNode {
+// SA-IS: classify suffixes as S/L, sort the LMS substrings by induced
+// sorting, recurse on their names if any repeat, then induce the rest.
+// Symbols are in [0, upper].
+static vector<int32_t> buildSuffixArray(const vector<int32_t>& s, int32_t upper) {
+    int32_t len = static_cast<int32_t>(s.size());
+    if (len == 0) return {};
+    if (len == 1) return {0};
+    if (len == 2) return s[0] < s[1] ? vector<int32_t>{0, 1} : vector<int32_t>{1, 0};
+
+    vector<int32_t> order(len);
+    vector<bool> isS(len);
+    for (int32_t i = len - 2; i >= 0; i--)
+        isS[i] = s[i] == s[i + 1] ? isS[i + 1] : s[i] < s[i + 1];
+
+    // Bucket boundaries: L-type suffixes fill a bucket from the front,
+    // S-type ones from the back
+    vector<int32_t> sumL(upper + 1), sumS(upper + 1);
+    for (int32_t i = 0; i < len; i++) {
+        if (!isS[i]) sumS[s[i]]++;
+        else sumL[s[i] + 1]++;
+    }
+    for (int32_t c = 0; c <= upper; c++) {
+        sumS[c] += sumL[c];
+        if (c < upper) sumL[c + 1] += sumS[c];
+    }
+
+    auto induce = [&](const vector<int32_t>& lms) {
+        fill(order.begin(), order.end(), -1);
+        vector<int32_t> bucket(sumS);
+        for (int32_t d : lms)
+            if (d != len) order[bucket[s[d]]++] = d;
+        bucket = sumL;
+        order[bucket[s[len - 1]]++] = len - 1;
+        for (int32_t i = 0; i < len; i++) {
+            int32_t v = order[i];
+            if (v >= 1 && !isS[v - 1]) order[bucket[s[v - 1]]++] = v - 1;
+        }
+        bucket = sumL;
+        for (int32_t i = len - 1; i >= 0; i--) {
+            int32_t v = order[i];
+            if (v >= 1 && isS[v - 1]) order[--bucket[s[v - 1] + 1]] = v - 1;
+        }
+    };
+
+    vector<int32_t> lmsIndex(len + 1, -1);
+    vector<int32_t> lms;
+    for (int32_t i = 1; i < len; i++) {
+        if (!isS[i - 1] && isS[i]) {
+            lmsIndex[i] = static_cast<int32_t>(lms.size());
+            lms.push_back(i);
+        }
+    }
+    int32_t m = static_cast<int32_t>(lms.size());
+    induce(lms);
+    if (m == 0) return order;
+
+    // Name LMS substrings in sorted order; equal substrings share a name
+    vector<int32_t> sortedLms;
+    sortedLms.reserve(m);
+    for (int32_t v : order)
+        if (lmsIndex[v] != -1) sortedLms.push_back(v);
+
+    vector<int32_t> reduced(m);
+    int32_t reducedUpper = 0;
+    reduced[lmsIndex[sortedLms[0]]] = 0;
+    for (int32_t i = 1; i < m; i++) {
+        int32_t l = sortedLms[i - 1], r = sortedLms[i];
+        int32_t endL = lmsIndex[l] + 1 < m ? lms[lmsIndex[l] + 1] : len;
+        int32_t endR = lmsIndex[r] + 1 < m ? lms[lmsIndex[r] + 1] : len;
+        bool same = endL - l == endR - r;
+        if (same) {
+            while (l < endL && s[l] == s[r]) {
+                l++;
+                r++;
+            }
+            if (l == len || s[l] != s[r]) same = false;
+        }
+        if (!same) reducedUpper++;
+        reduced[lmsIndex[sortedLms[i]]] = reducedUpper;
+    }
+
+    vector<int32_t> reducedOrder = buildSuffixArray(reduced, reducedUpper);
+    for (int32_t i = 0; i < m; i++) sortedLms[i] = lms[reducedOrder[i]];
+    induce(sortedLms);
+    return order;
+}
+
+// Suffix array + LCP index over the metadata text.
+// Built in O(n) with SA-IS and Kasai, stored as 32-bit arrays (9 bytes per
+// character including the text), and persisted in a layout that can be
+// memory-mapped straight back in, so a restarted service searches at once.
+class SuffixArrayIndex {
 public:
-    unordered_map<char, SuffixTreeNode*> children;
-    vector<int> indexes; // Stores indexes of suffixes
-
-    void insertSuffix(const string& s, int index) {
-        indexes.push_back(index);
-        if (!s.empty()) {
-            char firstChar = s[0];
-            if (children.find(firstChar) == children.end()) {
-                children[firstChar] = new SuffixTreeNode();
+    // Positions of one pattern's occurrences: a slice of the suffix array,
+    // in suffix order rather than text order, returned without allocating
+    struct Occurrences {
+        const uint32_t* first;
+        const uint32_t* last;
+        const uint32_t* begin() const { return first; }
+        const uint32_t* end() const { return last; }
+        size_t size() const { return last - first; }
+        bool empty() const { return first == last; }
+    };
+
+    explicit SuffixArrayIndex(string metadata) : textStorage(move(metadata)) {
+        // SA-IS works on int32_t positions
+        if (textStorage.size() >= INT32_MAX)
+            throw length_error("SuffixArrayIndex supports texts below 2 GiB");
+        n = textStorage.size();
+
+        vector<int32_t> symbols(textStorage.begin(), textStorage.end());
+        for (auto& c : symbols) c = static_cast<unsigned char>(c);
+        vector<int32_t> order = buildSuffixArray(symbols, 255);
+        saStorage.assign(order.begin(), order.end());
+        lcpStorage = buildLcp(textStorage, saStorage);
+        pointAtStorage();
+    }
+
+    SuffixArrayIndex(SuffixArrayIndex&& other) noexcept { *this = move(other); }
+
+    SuffixArrayIndex& operator=(SuffixArrayIndex&& other) noexcept {
+        if (this == &other) return *this;
+        release();
+        textStorage = move(other.textStorage);
+        saStorage = move(other.saStorage);
+        lcpStorage = move(other.lcpStorage);
+        mapping = other.mapping;
+        mappingBytes = other.mappingBytes;
+        n = other.n;
+        if (mapping) {
+            text = other.text;
+            sa = other.sa;
+            lcp = other.lcp;
+        } else {
+            pointAtStorage(); // Short strings live inline, so re-derive pointers
+        }
+        other.mapping = nullptr;
+        other.n = 0;
+        other.pointAtStorage();
+        return *this;
+    }
+
+    SuffixArrayIndex(const SuffixArrayIndex&) = delete;
+    SuffixArrayIndex& operator=(const SuffixArrayIndex&) = delete;
+
+    ~SuffixArrayIndex() { release(); }
+
+    // All occurrences of pattern by two binary searches over the suffix array
+    Occurrences searchPattern(string_view pattern) const {
+        const uint32_t* lo = lower_bound(sa, sa + n, pattern,
+            [&](uint32_t suffix, string_view p) { return comparePrefix(suffix, p) < 0; });
+        const uint32_t* hi = upper_bound(lo, sa + n, pattern,
+            [&](string_view p, uint32_t suffix) { return comparePrefix(suffix, p) > 0; });
+        return {lo, hi};
+    }
+
+    // Longest substring occurring at least twice, straight from the LCP array
+    string_view longestRepeatedSubstring() const {
+        const uint32_t* best = max_element(lcp, lcp + n);
+        if (best == lcp + n || *best == 0) return {};
+        return string_view(text + sa[best - lcp], *best);
+    }
+
+    size_t size() const { return n; }
+    string_view metadata() const { return string_view(text, n); }
+
+    // File layout: header, text padded to 4 bytes, suffix array, LCP array
+    void save(const string& path) const {
+        FILE* out = fopen(path.c_str(), "wb");
+        if (!out) throw runtime_error("cannot open " + path + " for writing");
+        FileHeader header{};
+        memcpy(header.magic, MAGIC, sizeof(header.magic));
+        header.length = n;
+        static const char padding[4] = {};
+        bool ok = fwrite(&header, sizeof(header), 1, out) == 1 &&
+                  fwrite(text, 1, n, out) == n &&
+                  fwrite(padding, 1, paddedTextBytes(n) - n, out) == paddedTextBytes(n) - n &&
+                  fwrite(sa, sizeof(uint32_t), n, out) == n &&
+                  fwrite(lcp, sizeof(uint32_t), n, out) == n;
+        ok = fclose(out) == 0 && ok;
+        if (!ok) throw runtime_error("failed writing " + path);
+    }
+
+    // Maps a saved index read-only; nothing is parsed or copied
+    static SuffixArrayIndex load(const string& path) {
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) throw runtime_error("cannot open " + path);
+        struct stat st;
+        if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(FileHeader)) {
+            close(fd);
+            throw runtime_error(path + " is not a suffix array index");
+        }
+        size_t bytes = st.st_size;
+        void* base = mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+        if (base == MAP_FAILED) throw runtime_error("cannot map " + path);
+
+        const FileHeader* header = static_cast<const FileHeader*>(base);
+        size_t length = header->length;
+        if (memcmp(header->magic, MAGIC, sizeof(header->magic)) != 0 ||
+            bytes != sizeof(FileHeader) + paddedTextBytes(length) + 8 * length) {
+            munmap(base, bytes);
+            throw runtime_error(path + " is not a suffix array index");
+        }
+
+        SuffixArrayIndex index;
+        const char* bodyStart = static_cast<const char*>(base) + sizeof(FileHeader);
+        index.mapping = base;
+        index.mappingBytes = bytes;
+        index.n = length;
+        index.text = bodyStart;
+        index.sa = reinterpret_cast<const uint32_t*>(bodyStart + paddedTextBytes(length));
+        index.lcp = index.sa + length;
+        return index;
+    }
+
+private:
+    static constexpr char MAGIC[8] = {'S', 'A', 'I', 'D', 'X', '0', '0', '1'};
+
+    struct FileHeader {
+        char magic[8];
+        uint64_t length;
+    };
+
+    string textStorage;
+    vector<uint32_t> saStorage;
+    vector<uint32_t> lcpStorage;
+    void* mapping = nullptr;
+    size_t mappingBytes = 0;
+
+    // Views used by every query, over either owned storage or the mapping
+    const char* text = nullptr;
+    const uint32_t* sa = nullptr;
+    const uint32_t* lcp = nullptr;
+    size_t n = 0;
+
+    SuffixArrayIndex() = default;
+
+    static size_t paddedTextBytes(size_t length) { return (length + 3) & ~size_t(3); }
+
+    void pointAtStorage() {
+        text = textStorage.data();
+        sa = saStorage.data();
+        lcp = lcpStorage.data();
+    }
+
+    void release() {
+        if (mapping) munmap(mapping, mappingBytes);
+        mapping = nullptr;
+    }
+
+    // Compares the suffix's first |p| characters with p
+    int comparePrefix(uint32_t suffix, string_view p) const {
+        size_t available = n - suffix;
+        int c = memcmp(text + suffix, p.data(), min(available, p.size()));
+        if (c != 0) return c;
+        return available < p.size() ? -1 : 0;
+    }
+
+    // Kasai: walking suffixes in text order, the LCP with the previous
+    // suffix in sorted order drops by at most one each step
+    static vector<uint32_t> buildLcp(const string& s, const vector<uint32_t>& order) {
+        size_t len = s.size();
+        vector<uint32_t> rank(len), result(len, 0);
+        for (size_t i = 0; i < len; i++) rank[order[i]] = static_cast<uint32_t>(i);
+        uint32_t h = 0;
+        for (size_t i = 0; i < len; i++) {
+            if (rank[i] == 0) {
+                h = 0;
+                continue;
             }
-            children[firstChar]->insertSuffix(s.substr(1), index);
+            size_t j = order[rank[i] - 1];
+            while (i + h < len && j + h < len && s[i + h] == s[j + h]) h++;
+            result[rank[i]] = h;
+            if (h > 0) h--;
         }
+        return result;
+    }
+};
+
+// Rank-ready bitvector: one cumulative count per 512 bits (6.25% overhead),
+// so rank1() is one table read plus at most eight popcounts, all within one
+// cache line of words.
+class RankBitVector {
+    vector<uint64_t> words;
+    vector<uint32_t> blockRank;
+    size_t bits = 0;
+
+public:
+    // Exact sizing up front, so building leaves no vector growth slack
+    void reserve(size_t totalBits) { words.reserve(totalBits / 64 + 2); }
+
+    void push_back(bool bit) {
+        if ((bits & 63) == 0) words.push_back(0);
+        if (bit) words.back() |= uint64_t(1) << (bits & 63);
+        bits++;
     }
 
-    vector<int> search(const string& pattern) {
-        if (pattern.empty()) return indexes;
-        char firstChar = pattern[0];
-        if (children.find(firstChar) != children.end()) {
-            return children[firstChar]->search(pattern.substr(1));
+    // Call once after the last push_back
+    void buildRank() {
+        words.push_back(0); // rank1(size()) may touch one word past the end
+        blockRank.assign(words.size() / 8 + 1, 0);
+        uint32_t running = 0;
+        for (size_t w = 0; w < words.size(); w++) {
+            if ((w & 7) == 0) blockRank[w >> 3] = running;
+            running += __builtin_popcountll(words[w]);
         }
-        return {};
     }
+
+    bool operator[](size_t i) const { return (words[i >> 6] >> (i & 63)) & 1; }
+
+    // Number of set bits in [0, i)
+    size_t rank1(size_t i) const {
+        size_t word = i >> 6;
+        size_t count = blockRank[word >> 3];
+        for (size_t w = word & ~size_t(7); w < word; w++) count += __builtin_popcountll(words[w]);
+        return count + __builtin_popcountll(words[word] & ((uint64_t(1) << (i & 63)) - 1));
+    }
+
+    size_t size() const { return bits; }
+    size_t bytes() const { return words.capacity() * 8 + blockRank.capacity() * 4; }
 };
 
-class SuffixTree {
-    SuffixTreeNode root;
+// Fixed-width unsigned integers packed back to back into 64-bit words
+class PackedIntVector {
+    vector<uint64_t> words;
+    int width = 1;
+    size_t count = 0;
+
 public:
-    SuffixTree(const string& text) {
-        for (int i = 0; i < text.size(); i++) {
-            root.insertSuffix(text.substr(i), i);
+    explicit PackedIntVector(int width = 1) : width(width) {}
+
+    void reserve(size_t values) { words.reserve((values * width + 63) >> 6); }
+
+    void push_back(uint64_t value) {
+        size_t bit = count * width;
+        words.resize((bit + width + 63) >> 6, 0);
+        words[bit >> 6] |= value << (bit & 63);
+        if ((bit & 63) + width > 64) words[(bit >> 6) + 1] |= value >> (64 - (bit & 63));
+        count++;
+    }
+
+    uint64_t operator[](size_t i) const {
+        size_t bit = i * width, word = bit >> 6, offset = bit & 63;
+        uint64_t value = words[word] >> offset;
+        if (offset + width > 64) value |= words[word + 1] << (64 - offset);
+        return width == 64 ? value : value & ((uint64_t(1) << width) - 1);
+    }
+
+    size_t size() const { return count; }
+    size_t bytes() const { return words.capacity() * 8; }
+};
+
+// Compressed full-text index: the BWT stored in a Huffman-shaped wavelet
+// tree (about H0 bits per character) plus suffix array samples taken every
+// `sampleRate` text positions, packed into ceil(log2 n) bits each. count()
+// is a backward search costing one wavelet rank per pattern character;
+// locate() walks LF at most sampleRate-1 steps per occurrence. Larger
+// sampleRate trades locate speed for space.
+class FMIndex {
+    static constexpr int SIGMA = 257; // Sentinel 0, then byte values shifted by one
+
+public:
+    static constexpr uint32_t DEFAULT_SAMPLE_RATE = 64; // ~0.8 bytes/char on tag metadata
+
+private:
+    struct WaveletNode {
+        RankBitVector bits;
+        int32_t child[2] = {-1, -1};  // Node index, or -(symbol + 1) for a leaf
+    };
+
+    vector<WaveletNode> nodes;        // nodes[0] is the root
+    vector<uint64_t> codeBits;        // Huffman code per symbol, root bit first
+    vector<uint8_t> codeLength;
+    vector<uint64_t> before;          // C array: symbols smaller than c in the BWT
+    RankBitVector sampled;            // BWT rows whose text position is sampled
+    PackedIntVector samples;          // Text positions of sampled rows, in row order
+    uint32_t sampleRate;
+    size_t rows = 0;                  // Text length plus the sentinel
+
+    static int symbolOf(char c) { return static_cast<unsigned char>(c) + 1; }
+
+    // Occurrences of symbol c in BWT[0, i)
+    size_t rank(int c, size_t i) const {
+        int node = 0;
+        for (int depth = 0; depth < codeLength[c]; depth++) {
+            bool bit = (codeBits[c] >> depth) & 1;
+            size_t ones = nodes[node].bits.rank1(i);
+            i = bit ? ones : i - ones;
+            int next = nodes[node].child[bit];
+            if (next < 0) break;
+            node = next;
+        }
+        return i;
+    }
+
+    // Last-to-first mapping: row of the suffix starting one position earlier
+    size_t lf(size_t row) const {
+        int node = 0;
+        while (true) {
+            bool bit = nodes[node].bits[row];
+            size_t ones = nodes[node].bits.rank1(row);
+            row = bit ? ones : row - ones;
+            int next = nodes[node].child[bit];
+            if (next < 0) return before[-next - 1] + row;
+            node = next;
         }
     }
 
-    vector<int> searchPattern(const string& pattern) {
-        return root.search(pattern);
+    void buildHuffmanShape(const vector<uint64_t>& freq) {
+        using Item = pair<uint64_t, int32_t>; // (weight, node id or leaf code)
+        priority_queue<Item, vector<Item>, greater<Item>> heap;
+        for (int c = 0; c < SIGMA; c++)
+            if (freq[c]) heap.emplace(freq[c], -(c + 1));
+        if (heap.size() == 1) heap.emplace(0, -(SIGMA + 1)); // Give a lone symbol a sibling
+
+        vector<array<int32_t, 2>> merged;
+        while (heap.size() > 1) {
+            Item a = heap.top(); heap.pop();
+            Item b = heap.top(); heap.pop();
+            merged.push_back({a.second, b.second});
+            heap.emplace(a.first + b.first, static_cast<int32_t>(merged.size() - 1));
+        }
+
+        // Renumber so the root comes first, assigning codes on the way down
+        nodes.resize(merged.size());
+        codeBits.assign(SIGMA + 1, 0);
+        codeLength.assign(SIGMA + 1, 0);
+        vector<tuple<int32_t, int32_t, uint64_t, int>> stack = {{heap.top().second, 0, 0, 0}};
+        int32_t nextId = 1;
+        while (!stack.empty()) {
+            auto [mergedId, nodeId, code, depth] = stack.back();
+            stack.pop_back();
+            for (int bit = 0; bit < 2; bit++) {
+                int32_t child = merged[mergedId][bit];
+                uint64_t childCode = code | (uint64_t(bit) << depth);
+                if (child < 0) {
+                    nodes[nodeId].child[bit] = child;
+                    codeBits[-child - 1] = childCode;
+                    codeLength[-child - 1] = depth + 1;
+                } else {
+                    nodes[nodeId].child[bit] = nextId;
+                    stack.emplace_back(child, nextId++, childCode, depth + 1);
+                }
+            }
+        }
+    }
+
+public:
+    explicit FMIndex(const string& metadata, uint32_t sampleRate = DEFAULT_SAMPLE_RATE) : sampleRate(sampleRate) {
+        if (metadata.size() >= INT32_MAX)
+            throw length_error("FMIndex supports texts below 2 GiB per shard");
+        if (sampleRate == 0) throw invalid_argument("sampleRate must be positive");
+        rows = metadata.size() + 1;
+        samples = PackedIntVector(rows > 1 ? 64 - __builtin_clzll(rows - 1) : 1); // ceil(log2 rows) bits each
+
+        vector<int32_t> symbols(rows, 0);
+        for (size_t i = 0; i < metadata.size(); i++) symbols[i] = symbolOf(metadata[i]);
+        vector<int32_t> order = buildSuffixArray(symbols, SIGMA - 1);
+
+        vector<uint64_t> freq(SIGMA, 0);
+        for (int32_t c : symbols) freq[c]++;
+        before.assign(SIGMA, 0);
+        for (int c = 1; c < SIGMA; c++) before[c] = before[c - 1] + freq[c - 1];
+        buildHuffmanShape(freq);
+
+        // Every symbol adds one bit per occurrence to each node on its code
+        // path; reserving those totals keeps the index at its exact size
+        vector<size_t> nodeBits(nodes.size(), 0);
+        for (int c = 0; c < SIGMA; c++) {
+            int node = 0;
+            for (int depth = 0; freq[c] && node >= 0 && depth < codeLength[c]; depth++) {
+                nodeBits[node] += freq[c];
+                node = nodes[node].child[(codeBits[c] >> depth) & 1];
+            }
+        }
+        for (size_t node = 0; node < nodes.size(); node++) nodes[node].bits.reserve(nodeBits[node]);
+        sampled.reserve(rows);
+        samples.reserve((rows - 1) / sampleRate + 1);
+
+        // Each BWT symbol appends one bit to every node on its code path, in
+        // row order, which is exactly that node's subsequence
+        for (size_t row = 0; row < rows; row++) {
+            int c = order[row] == 0 ? 0 : symbols[order[row] - 1];
+            int node = 0;
+            for (int depth = 0; node >= 0 && depth < codeLength[c]; depth++) {
+                bool bit = (codeBits[c] >> depth) & 1;
+                nodes[node].bits.push_back(bit);
+                node = nodes[node].child[bit];
+            }
+            bool keep = order[row] % sampleRate == 0;
+            sampled.push_back(keep);
+            if (keep) samples.push_back(order[row]);
+        }
+        for (auto& node : nodes) node.bits.buildRank();
+        sampled.buildRank();
     }
+
+    // Half-open BWT row range of suffixes starting with pattern
+    pair<size_t, size_t> findRows(string_view pattern) const {
+        size_t lo = 0, hi = rows;
+        for (size_t k = pattern.size(); k-- > 0 && lo < hi;) {
+            int c = symbolOf(pattern[k]);
+            if (codeLength[c] == 0) return {0, 0};
+            lo = before[c] + rank(c, lo);
+            hi = before[c] + rank(c, hi);
+        }
+        return lo < hi ? make_pair(lo, hi) : make_pair(size_t(0), size_t(0));
+    }
+
+    size_t count(string_view pattern) const {
+        auto [lo, hi] = findRows(pattern);
+        return hi - lo;
+    }
+
+    // Text positions of every occurrence, in suffix order
+    vector<uint32_t> locate(string_view pattern) const {
+        auto [lo, hi] = findRows(pattern);
+        vector<uint32_t> positions;
+        positions.reserve(hi - lo);
+        for (size_t row = lo; row < hi; row++) {
+            size_t r = row;
+            uint32_t steps = 0;
+            while (!sampled[r]) {
+                r = lf(r);
+                steps++;
+            }
+            positions.push_back(static_cast<uint32_t>(samples[sampled.rank1(r)]) + steps);
+        }
+        return positions;
+    }
+
+    size_t bytes() const {
+        // Allocated capacity, not element counts: this is the real heap cost
+        size_t total = sizeof(*this) + sampled.bytes() + samples.bytes() + before.capacity() * 8 +
+                       codeBits.capacity() * 8 + codeLength.capacity() + nodes.capacity() * sizeof(WaveletNode);
+        for (const auto& node : nodes) total += node.bits.bytes();
+        return total;
+    }
+
+    size_t size() const { return rows - 1; }
 };
 
+static void printPositions(const string& label, SuffixArrayIndex::Occurrences hits) {
+    vector<uint32_t> positions(hits.begin(), hits.end());
+    sort(positions.begin(), positions.end());
+    cout << label;
+    for (uint32_t pos : positions) cout << pos << " ";
+    cout << endl;
+}
+
+// Synthetic metadata corpus of comma-separated regional tags
+static string makeMetadataCorpus(size_t bytes) {
+    const vector<string> regions = {"us", "fr", "es", "jp", "de", "br", "in", "kr"};
+    const vector<string> kinds = {"ad_campaign", "movie_trailer", "tv_show", "movie", "documentary"};
+    mt19937 rng(7);
+    string corpus;
+    corpus.reserve(bytes + 64);
+    while (corpus.size() < bytes) {
+        corpus += regions[rng() % regions.size()] + "_" + kinds[rng() % kinds.size()] +
+                  "_s" + to_string(rng() % 40) + "e" + to_string(rng() % 24) + ",";
+    }
+    return corpus;
+}
+
+// Size and query latency of the suffix array against the FM-index
+static void benchmarkIndexes(size_t corpusBytes) {
+    using Clock = chrono::steady_clock;
+    string corpus = makeMetadataCorpus(corpusBytes);
+    vector<string> patterns = {"us_", "_ad_", "movie", "jp_tv_show_s1", "kr_documentary_s3"};
+
+    auto timeQueries = [&](auto&& query) {
+        size_t checksum = 0;
+        auto start = Clock::now();
+        for (int round = 0; round < 200; round++)
+            for (const auto& p : patterns) checksum += query(p);
+        double ns = chrono::duration<double, nano>(Clock::now() - start).count();
+        return make_pair(ns / (200 * patterns.size()), checksum);
+    };
+
+    SuffixArrayIndex sa(corpus);
+    size_t saBytes = sa.size() * 9;
+    auto [saCountNs, saCount] = timeQueries([&](const string& p) { return sa.searchPattern(p).size(); });
+
+    cout << "Corpus: " << corpus.size() / 1024 << " KiB" << endl;
+    cout << "  SuffixArrayIndex: " << double(saBytes) / corpus.size() << " bytes/char, count "
+         << saCountNs / 1000 << " us" << endl;
+
+    for (uint32_t rate : {16u, 32u, FMIndex::DEFAULT_SAMPLE_RATE}) {
+        FMIndex fm(corpus, rate);
+        auto [fmCountNs, fmCount] = timeQueries([&](const string& p) { return fm.count(p); });
+        auto start = Clock::now();
+        size_t located = fm.locate("kr_documentary_s3").size();
+        double locateUs = chrono::duration<double, micro>(Clock::now() - start).count();
+        cout << "  FMIndex (sample " << rate << (rate == FMIndex::DEFAULT_SAMPLE_RATE ? ", default" : "")
+             << "): " << double(fm.bytes()) / corpus.size()
+             << " bytes/char, count " << fmCountNs / 1000 << " us, locate " << located
+             << " hits in " << locateUs << " us" << (fmCount == saCount ? "" : " MISMATCH") << endl;
+    }
+}
+
 int main() {
     // Example: Video metadata containing regional tags
     string videoMetadata = "us_ad_campaign,fr_movie_trailer,es_tv_show,jp_ad_campaign,us_movie";
-    
-    SuffixTree st(videoMetadata);
-    
+
+    SuffixArrayIndex index(videoMetadata);
+
     // Search for all content for US market
-    vector<int> usResults = st.searchPattern("us_");
-    cout << "US content found at positions: ";
-    for (int pos : usResults) cout << pos << " ";
-    cout << endl;
-    
+    printPositions("US content found at positions: ", index.searchPattern("us_"));
+
     // Search for all ad campaigns
-    vector<int> adResults = st.searchPattern("_ad_");
-    cout << "Ad campaigns found at positions: ";
-    for (int pos : adResults) cout << pos << " ";
-    cout << endl;
-    
+    printPositions("Ad campaigns found at positions: ", index.searchPattern("_ad_"));
+
+    cout << "Longest repeated tag fragment: \"" << index.longestRepeatedSubstring() << "\"" << endl;
+
+    // Persist once, then a restarted service maps the index instead of rebuilding it
+    string path = "/tmp/video_metadata.saidx";
+    index.save(path);
+    SuffixArrayIndex restored = SuffixArrayIndex::load(path);
+    cout << "Movie entries after reload: " << restored.searchPattern("movie").size() << endl;
+    unlink(path.c_str());
+
+    // Compressed alternative for corpora too large for 9 bytes per character
+    FMIndex compressed(videoMetadata, 4);
+    cout << "FM-index ad campaigns: " << compressed.count("_ad_") << endl;
+    benchmarkIndexes(8 << 20);
+
     return 0;
-}
\ No newline at end of file
+}
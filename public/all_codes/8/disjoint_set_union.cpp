@@ -1,103 +1,341 @@
 #include <iostream>
 #include <vector>
-#include <unordered_map>
+#include <string>
+#include <atomic>
+#include <thread>
+#include <memory>
+#include <functional>
+#include <stdexcept>
+#include <queue>
+#include <algorithm>
 using namespace std;
 
+// Concurrent union-find shared by many ingestion threads.
+// Parents live in a flat atomic array: links are a single CAS on a root,
+// finds compress paths by splitting, and no operation ever takes a lock.
+// Each node also records the roots that were linked directly under it, so
+// listing a blast radius walks only that set's members.
 class PerformanceAnalyzer {
-    vector<int> parent;
-    vector<int> rank;
-    unordered_map<string, int> componentIds;
-    int nextId = 0;
-    
-    int find(int u) {
-        if (parent[u] != u)
-            parent[u] = find(parent[u]); // Path compression
-        return parent[u];
-    }
-    
-    void unionSets(int u, int v) {
-        u = find(u);
-        v = find(v);
-        if (u == v) return;
-        
-        // Union by rank
-        if (rank[u] > rank[v]) {
-            parent[v] = u;
-        } else {
-            parent[u] = v;
-            if (rank[u] == rank[v])
-                rank[v]++;
+    static constexpr uint32_t EMPTY = UINT32_MAX; // No id / end of a child list
+
+    // Entry of the lock-free name -> id table. It is built in full, id
+    // included, before one CAS makes it visible, so probes never wait on it.
+    struct Record {
+        string name;
+        uint32_t id;
+        atomic<bool> inTable{false}; // False if a racing twin published the name first
+    };
+
+    size_t capacity;
+    size_t slotMask;
+    unique_ptr<atomic<uint32_t>[]> parent;
+    unique_ptr<atomic<Record*>[]> recordOf; // id -> record, owned here
+    unique_ptr<atomic<const Record*>[]> slots; // Open addressing, null = free
+    atomic<uint32_t> nextId{0};
+
+    // Union tree: a root linked under v is pushed onto v's child list once
+    // and never removed, so the subtree of a root is exactly its set
+    unique_ptr<atomic<uint32_t>[]> firstChild;
+    unique_ptr<atomic<uint32_t>[]> nextSibling;
+
+    // Per-set counters, exact at roots once concurrent links settle
+    unique_ptr<atomic<uint64_t>[]> setSize;
+    unique_ptr<atomic<uint64_t>[]> setIncidents; // Links reported into the set
+
+    // Random linking order (Jayanti-Tarjan): a fixed pseudo-random priority
+    // per id keeps trees shallow without a rank array to keep consistent.
+    static uint64_t priority(uint32_t u) {
+        uint64_t x = u + 0x9E3779B97F4A7C15ULL;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+        return x ^ (x >> 31);
+    }
+
+    static bool linksBelow(uint32_t u, uint32_t v) {
+        uint64_t pu = priority(u), pv = priority(v);
+        return pu < pv || (pu == pv && u < v);
+    }
+
+    uint32_t find(uint32_t u) const {
+        while (true) {
+            uint32_t p = parent[u].load(memory_order_acquire);
+            uint32_t gp = parent[p].load(memory_order_acquire);
+            if (p == gp) return p;
+            // Path splitting: point u at its grandparent, then step to p.
+            // A failed CAS only means someone else already shortened it.
+            parent[u].compare_exchange_weak(p, gp, memory_order_release, memory_order_relaxed);
+            u = p;
+        }
+    }
+
+    // Adds counts to the set containing node. If the root being credited is
+    // linked away concurrently, whichever of us or the linker drains it last
+    // forwards the counts, so nothing is lost. Sequentially consistent
+    // ordering makes "add, then check parent" and "link, then drain" meet.
+    void credit(uint32_t node, uint64_t members, uint64_t incidents) {
+        while (members || incidents) {
+            uint32_t root = find(node);
+            setSize[root].fetch_add(members);
+            setIncidents[root].fetch_add(incidents);
+            if (parent[root].load() == root) return;
+            members = setSize[root].exchange(0);
+            incidents = setIncidents[root].exchange(0);
+            node = root;
         }
     }
-    
+
+    // Links the sets of u and v and charges one incident to the result
+    bool unionSets(uint32_t u, uint32_t v) {
+        while (true) {
+            u = find(u);
+            v = find(v);
+            if (u == v) {
+                credit(u, 0, 1);
+                return false;
+            }
+            if (linksBelow(v, u)) swap(u, v);
+            // Only a root may be re-parented; retry if u stopped being one
+            uint32_t expected = u;
+            if (!parent[u].compare_exchange_strong(expected, v)) continue;
+
+            // u is linked and owned by this call: hang it under v, then move
+            // its counters (and any that raced in) to the surviving root
+            uint32_t head = firstChild[v].load(memory_order_relaxed);
+            do {
+                nextSibling[u].store(head, memory_order_relaxed);
+            } while (!firstChild[v].compare_exchange_weak(head, u, memory_order_release,
+                                                          memory_order_relaxed));
+            credit(v, setSize[u].exchange(0), setIncidents[u].exchange(0) + 1);
+            return true;
+        }
+    }
+
+    bool sameSet(uint32_t u, uint32_t v) const {
+        while (true) {
+            u = find(u);
+            v = find(v);
+            if (u == v) return true;
+            // u is still a root, so the two sets were disjoint at this instant
+            if (parent[u].load(memory_order_acquire) == u) return false;
+        }
+    }
+
+    // Returns the id for name, or EMPTY if it has not been registered
+    uint32_t lookup(const string& name) const {
+        size_t i = hash<string>{}(name) & slotMask;
+        while (true) {
+            const Record* record = slots[i].load(memory_order_acquire);
+            if (!record) return EMPTY;
+            if (record->name == name) return record->id;
+            i = (i + 1) & slotMask;
+        }
+    }
+
+    // Takes the next id and prepares its node and record, all still private
+    Record* reserve(const string& name) {
+        uint32_t newId = nextId.load(memory_order_relaxed);
+        do {
+            if (newId >= capacity) throw length_error("PerformanceAnalyzer capacity exceeded");
+        } while (!nextId.compare_exchange_weak(newId, newId + 1, memory_order_relaxed));
+        parent[newId].store(newId, memory_order_relaxed);
+        firstChild[newId].store(EMPTY, memory_order_relaxed);
+        setSize[newId].store(1, memory_order_relaxed);
+        setIncidents[newId].store(0, memory_order_relaxed);
+        Record* record = new Record{name, newId};
+        recordOf[newId].store(record, memory_order_release);
+        return record;
+    }
+
 public:
-    PerformanceAnalyzer() {
+    explicit PerformanceAnalyzer(size_t maxComponents = 1 << 16)
+        : capacity(maxComponents) {
+        if (maxComponents >= EMPTY)
+            throw length_error("PerformanceAnalyzer ids must stay below the EMPTY sentinel");
+        size_t tableSize = 1;
+        while (tableSize < 2 * maxComponents) tableSize <<= 1;
+        slotMask = tableSize - 1;
+        parent = make_unique<atomic<uint32_t>[]>(maxComponents);
+        recordOf = make_unique<atomic<Record*>[]>(maxComponents);
+        slots = make_unique<atomic<const Record*>[]>(tableSize);
+        firstChild = make_unique<atomic<uint32_t>[]>(maxComponents);
+        nextSibling = make_unique<atomic<uint32_t>[]>(maxComponents);
+        setSize = make_unique<atomic<uint64_t>[]>(maxComponents);
+        setIncidents = make_unique<atomic<uint64_t>[]>(maxComponents);
+
         // Initialize with some common components
         registerComponent("Database");
         registerComponent("CDN");
         registerComponent("ImageProcessor");
     }
-    
-    int registerComponent(const string& name) {
-        if (!componentIds.count(name)) {
-            componentIds[name] = nextId;
-            parent.push_back(nextId);
-            rank.push_back(0);
-            nextId++;
+
+    ~PerformanceAnalyzer() {
+        for (uint32_t id = 0; id < nextId.load(); id++) delete recordOf[id].load();
+    }
+
+    // Safe to call concurrently; racing registrations of one name agree on
+    // its id. The loser of such a race leaves its reserved id unused.
+    uint32_t registerComponent(const string& name) {
+        size_t i = hash<string>{}(name) & slotMask;
+        Record* mine = nullptr;
+        while (true) {
+            const Record* record = slots[i].load(memory_order_acquire);
+            if (!record) {
+                if (!mine) mine = reserve(name);
+                if (slots[i].compare_exchange_strong(record, mine, memory_order_acq_rel,
+                                                     memory_order_acquire)) {
+                    mine->inTable.store(true, memory_order_release);
+                    return mine->id;
+                }
+                // Lost the slot: record is now the winner's entry
+            }
+            if (record->name == name) return record->id;
+            i = (i + 1) & slotMask;
         }
-        return componentIds[name];
     }
-    
-    void linkRelatedIssues(const string& comp1, const string& comp2) {
-        int id1 = registerComponent(comp1);
-        int id2 = registerComponent(comp2);
+
+    void linkRelatedIssues(const string& comp1, const string& comp2, bool verbose = true) {
+        uint32_t id1 = registerComponent(comp1);
+        uint32_t id2 = registerComponent(comp2);
         unionSets(id1, id2);
-        cout << "Linked performance issues between " << comp1 
-             << " and " << comp2 << endl;
+        if (verbose)
+            cout << "Linked performance issues between " << comp1
+                 << " and " << comp2 << endl;
     }
-    
-    bool areRelated(const string& comp1, const string& comp2) {
-        if (!componentIds.count(comp1) return false;
-        if (!componentIds.count(comp2)) return false;
-        return find(componentIds[comp1]) == find(componentIds[comp2]);
+
+    // Read-only: never writes except for benign path splitting, never blocks
+    bool areRelated(const string& comp1, const string& comp2) const {
+        uint32_t id1 = lookup(comp1);
+        if (id1 == EMPTY) return false;
+        uint32_t id2 = lookup(comp2);
+        if (id2 == EMPTY) return false;
+        return sameSet(id1, id2);
     }
-    
-    void analyzeBottleneck(const string& component) {
+
+    // Walks only the component's own set in the union tree: O(size of its
+    // set). Unions that land during the walk may or may not be included.
+    void analyzeBottleneck(const string& component) const {
         cout << "Performance issues in " << component << " may affect: ";
-        if (!componentIds.count(component)) {
+        uint32_t id = lookup(component);
+        if (id == EMPTY) {
             cout << "None (new component)" << endl;
             return;
         }
-        
-        int root = find(componentIds[component]);
+
+        uint32_t root = find(id);
+        vector<uint32_t> pending = {root};
         bool first = true;
-        for (auto& [name, id] : componentIds) {
-            if (find(id) == root && name != component) {
-                if (!first) cout << ", ";
-                cout << name;
-                first = false;
+        while (!pending.empty()) {
+            uint32_t member = pending.back();
+            pending.pop_back();
+            for (uint32_t child = firstChild[member].load(memory_order_acquire); child != EMPTY;
+                 child = nextSibling[child].load(memory_order_relaxed))
+                pending.push_back(child);
+            if (member == id) continue;
+            if (!first) cout << ", ";
+            cout << nameOf(member);
+            first = false;
+        }
+        cout << " (" << setSize[root].load() << " components, "
+             << setIncidents[root].load() << " linked incidents)" << endl;
+    }
+
+    struct IssueGroup {
+        string representative;
+        uint64_t size;
+        uint64_t incidents;
+    };
+
+    // The k largest connected issue groups, biggest first. One pass over the
+    // ids with a size-k min-heap: O(N log k), and only roots are inspected.
+    vector<IssueGroup> largestGroups(size_t k) const {
+        using Entry = pair<uint64_t, uint32_t>; // (size, root)
+        priority_queue<Entry, vector<Entry>, greater<Entry>> best;
+        uint32_t count = nextId.load(memory_order_acquire);
+        for (uint32_t id = 0; id < count && k > 0; id++) {
+            if (!isPublished(id) || parent[id].load(memory_order_acquire) != id) continue;
+            uint64_t size = setSize[id].load(memory_order_relaxed);
+            if (best.size() < k) best.emplace(size, id);
+            else if (size > best.top().first) {
+                best.pop();
+                best.emplace(size, id);
             }
         }
-        cout << endl;
+
+        vector<IssueGroup> groups;
+        while (!best.empty()) {
+            auto [size, root] = best.top();
+            best.pop();
+            groups.push_back({nameOf(root), size, setIncidents[root].load(memory_order_relaxed)});
+        }
+        reverse(groups.begin(), groups.end());
+        return groups;
+    }
+
+private:
+    bool isPublished(uint32_t id) const {
+        const Record* record = recordOf[id].load(memory_order_acquire);
+        return record && record->inTable.load(memory_order_acquire);
+    }
+
+    const string& nameOf(uint32_t id) const {
+        return recordOf[id].load(memory_order_acquire)->name;
     }
 };
 
 int main() {
     PerformanceAnalyzer analyzer;
-    
+
     // Link related performance issues
     analyzer.linkRelatedIssues("Database", "UserProfileService");
     analyzer.linkRelatedIssues("CDN", "ImageLoader");
     analyzer.linkRelatedIssues("ImageProcessor", "ThumbnailGenerator");
-    
+
+    // Several ingestion threads report correlated incidents at once
+    vector<thread> ingestors;
+    for (int t = 0; t < 4; t++) {
+        ingestors.emplace_back([&analyzer, t]() {
+            for (int i = 0; i < 1000; i++) {
+                string shard = "CacheShard" + to_string(t * 1000 + i);
+                analyzer.linkRelatedIssues(shard, i % 2 ? "Database" : "CDN", false);
+            }
+        });
+    }
+    for (auto& th : ingestors) th.join();
+
     // Detect a bottleneck
-    analyzer.analyzeBottleneck("Database");
-    analyzer.analyzeBottleneck("CDN");
-    
+    analyzer.analyzeBottleneck("ImageProcessor");
+
+    // Largest connected issue groups across the whole system
+    cout << "Largest issue groups:" << endl;
+    for (const auto& group : analyzer.largestGroups(2)) {
+        cout << "  " << group.representative << ": " << group.size << " components, "
+             << group.incidents << " incidents" << endl;
+    }
+
     // Check if components are related
     if (analyzer.areRelated("ImageLoader", "CDN")) {
         cout << "ImageLoader and CDN issues are related" << endl;
     }
-    
+    cout << "CacheShard1 and UserProfileService related: "
+         << (analyzer.areRelated("CacheShard1", "UserProfileService") ? "Yes" : "No") << endl;
+    cout << "CacheShard2 and UserProfileService related: "
+         << (analyzer.areRelated("CacheShard2", "UserProfileService") ? "Yes" : "No") << endl;
+
+    // A full analyzer reports the overflow and stays usable: nothing is
+    // written to the name table until an id has been secured
+    PerformanceAnalyzer small(4);
+    small.registerComponent("Queue");
+    for (int attempt = 0; attempt < 2; attempt++) {
+        try {
+            small.registerComponent("Scheduler");
+        } catch (const length_error& e) {
+            cout << "Registering Scheduler: " << e.what() << endl;
+        }
+    }
+    cout << "Scheduler and Queue related: "
+         << (small.areRelated("Scheduler", "Queue") ? "Yes" : "No") << endl;
+    cout << "Queue still linkable to CDN: ";
+    small.linkRelatedIssues("Queue", "CDN");
+
     return 0;
-}
\ No newline at end of file
+}